@@ -17,9 +17,10 @@ int main() {
     std::ofstream out("altermagnet_berry.csv");
     out << "kx,ky,Berry_curvature_FHS, berryCurvatureDiff\n";
 
+    BerryWorkspace ws; // Reused for every k-point
     for (const auto& k : mesh.getKPoints()) {
-        double berry_curvature_fhs  = berryCurvatureFHS(altermagnet, k, 1e-2, 1); // Band index 1
-        double berry_curvature_diff = berryCurvatureDifferential(altermagnet, k, 1e-2, 1); // Band index 1
+        double berry_curvature_fhs  = berryCurvatureFHS(altermagnet, k, 1e-2, 1, ws); // Band index 1
+        double berry_curvature_diff = berryCurvatureDifferential(altermagnet, k, 1e-2, 1, ws); // Band index 1
         out << k(0) << "," << k(1) << "," << berry_curvature_fhs << "," << berry_curvature_diff << "\n";
     }
     out.close();
@@ -26,7 +26,8 @@ int main() {
     const Eigen::Vector3d gradT(1.0, 0.0, 0.0); // Temperature gradient in x-direction
     const Eigen::Vector3d Bfield(0.0, 0.0, 0.0);  // x-direction
 
-    Mesh mesh(40, 40, 1, 1.0);
+    // Monkhorst–Pack mesh of the hexagonal Brillouin zone (each periodic image sampled once)
+    const Mesh mesh = Mesh::monkhorstPack(HaldaneModel().reciprocalBasis(), 40, 40);
 
     std::ofstream out("transport_vs_phi.csv");
     out << "phi,kubo_xx,kubo_xy,boltzmann_xx,boltzmann_xy\n";
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "hamiltonian.hpp"
+#include "two_band.hpp"
 #include <complex>
 #include <Eigen/Dense>
 #include <cmath>
@@ -11,7 +11,7 @@ using std::complex;
 
 /// @brief Altermagnet model for a two-dimensional system
 /// @file altermagnet.hpp
-class AltermagnetModel : public Hamiltonian {
+class AltermagnetModel : public TwoBandModel {
 public:
     /// @brief Constructor with default parameters
     /// @param t Hopping amplitude
@@ -20,35 +20,82 @@ public:
     AltermagnetModel(double t = 1.0, double J = 0.1, double lambda = 0.2)
         : t(t), J(J), lambda(lambda) {}
 
-    /// @brief Return the Hamiltonian matrix H(k) at wavevector k
-    /// @details The Hamiltonian includes scalar hopping, altermagnetic anisotropic spin splitting,
-    Mat Hk(const Vec& k) const override {
-        using namespace std::complex_literals;
+    /// @brief Periodicity of H(k): the half-angle spin-orbit terms repeat under (2π, ±2π), not 2π x̂
+    Eigen::Matrix3d reciprocalBasis() const override {
+        Eigen::Matrix3d b = Eigen::Matrix3d::Zero();
+        b.col(0) << 2.0 * M_PI, 2.0 * M_PI, 0.0;
+        b.col(1) << 2.0 * M_PI, -2.0 * M_PI, 0.0;
+        b.col(2) << 0.0, 0.0, 2.0 * M_PI;
+        return b;
+    }
+
+    /// @brief H(k) = eps * σ₀ + d ⋅ σ
+    void pauliVector(const Vec& k, double& eps, Eigen::Vector3d& d) const override {
         using std::cos, std::sin;
 
         // Extract components of the wavevector k
         double kx = k(0), ky = k(1);
-    
 
         // Scalar hopping (times identity matrix)
-        double eps = -2.0 * t * (cos(kx) + cos(ky));
+        eps = -2.0 * t * (cos(kx) + cos(ky));
+
+        // Optional spin-orbit terms (d_x, d_y) and altermagnetic anisotropic spin splitting (d_z)
+        d << lambda * sin((kx + ky) / 2.0), lambda * sin((ky - kx) / 2.0), J * (cos(kx) - cos(ky));
+    }
 
-        // Altermagnetic anisotropic spin splitting
-        double d_z = J * (cos(kx) - cos(ky));
+    /// @brief H(k) = t H_t(k) + J H_J(k) + λ H_λ(k)
+    int numTerms() const override { return 3; }
 
-        // Optional spin-orbit terms
-        double d_x = lambda * sin((kx + ky) / 2.0);
-        double d_y = lambda * sin((ky - kx) / 2.0);
+    /// @brief H_t = -2(cos kx + cos ky) σ₀, H_J = (cos kx - cos ky) σ_z,
+    /// H_λ = sin((kx + ky)/2) σ_x + sin((ky - kx)/2) σ_y
+    void termMatrices(const Vec& k, std::vector<Mat>& terms) const override {
+        using std::cos, std::sin;
+        const double cx = cos(k(0)), cy = cos(k(1));
+        const double sx = sin((k(0) + k(1)) / 2.0), sy = sin((k(1) - k(0)) / 2.0);
+
+        terms.resize(3);
+        for (auto& term : terms) term.setZero(2, 2);
+        terms[0](0, 0) = terms[0](1, 1) = -2.0 * (cx + cy);
+        terms[1](0, 0) = cx - cy;
+        terms[1](1, 1) = -(cx - cy);
+        terms[2](0, 1) = complex<double>(sx, -sy);
+        terms[2](1, 0) = complex<double>(sx, sy);
+    }
 
-        // Build Hamiltonian: H = eps * σ₀ + d ⋅ σ
-        Mat H = Mat::Zero(2, 2);  // Initialize a 2x2 matrix
+    Eigen::VectorXd termCoefficients() const override { return Eigen::Vector3d(t, J, lambda); }
+
+    /// @brief Analytic gradients of eps and d (zero along kz)
+    void pauliGradient(const Vec& k, Eigen::Vector3d& grad_eps, Eigen::Matrix3d& grad_d) const override {
+        using std::cos, std::sin;
+        const double kx = k(0), ky = k(1);
+        const double cs = cos((kx + ky) / 2.0), cd = cos((ky - kx) / 2.0);
 
-        H += eps * Mat::Identity(2, 2); // Scalar 
-        H += d_x * sigma_x();
-        H += d_y * sigma_y();
-        H += d_z * sigma_z();
-        return H;
+        grad_eps << 2.0 * t * sin(kx), 2.0 * t * sin(ky), 0.0;
+        grad_d << 0.5 * lambda * cs,  0.5 * lambda * cs, 0.0,
+                  -0.5 * lambda * cd, 0.5 * lambda * cd, 0.0,
+                  -J * sin(kx),       J * sin(ky),       0.0;
+    }
 
+    /// @brief Analytic second derivatives of eps and d (zero if either direction is kz)
+    bool pauliHessian(const Vec& k, int i, int j, double& eps_ij, Eigen::Vector3d& d_ij) const override {
+        using std::cos, std::sin;
+        const double kx = k(0), ky = k(1);
+        const double ss = sin((kx + ky) / 2.0), sd = sin((ky - kx) / 2.0);
+
+        if (i == 2 || j == 2) {
+            eps_ij = 0.0;
+            d_ij.setZero();
+        } else if (i != j) {
+            eps_ij = 0.0;
+            d_ij << -0.25 * lambda * ss, 0.25 * lambda * sd, 0.0;
+        } else if (i == 0) {
+            eps_ij = 2.0 * t * cos(kx);
+            d_ij << -0.25 * lambda * ss, -0.25 * lambda * sd, -J * cos(kx);
+        } else {
+            eps_ij = 2.0 * t * cos(ky);
+            d_ij << -0.25 * lambda * ss, -0.25 * lambda * sd, J * cos(ky);
+        }
+        return true;
     }
 
 private:
@@ -56,28 +103,4 @@ private:
     double J;      // Spin splitting parameter
     double lambda; // Spin-orbit coupling strength
 
-    /// @brief Pauli matrices \sigma_x
-    static Mat sigma_x() {
-        Mat m(2, 2);
-        m << 0, 1,
-              1, 0;
-        return m;
-    }
-
-    /// @brief Pauli matrices \sigma_y
-    static Mat sigma_y() {
-        Mat m(2, 2);
-        m << 0, -std::complex<double>(0,1),
-              std::complex<double>(0,1), 0;
-        return m;
-    }
-
-    /// @brief Pauli matrices \sigma_z
-    static Mat sigma_z() {
-        Mat m(2, 2);
-        m << 1, 0,
-              0, -1;
-        return m;
-    }
-
 };
\ No newline at end of file
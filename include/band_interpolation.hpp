@@ -0,0 +1,86 @@
+#pragma once
+#include "hamiltonian.hpp"
+#include "mesh.hpp"
+#include <Eigen/Dense>
+#include <array>
+#include <vector>
+
+/// @file band_interpolation.hpp
+/// @brief Fourier interpolation of band energies from a coarse grid to arbitrary k-points
+
+
+/// @brief Scratch buffers for BandInterpolator::evaluate (one per thread)
+struct InterpolationWorkspace {
+    std::array<Eigen::VectorXcd, 3> axisPhase; ///< exp(2πi f_d m) for each axis d and lattice index m
+    Eigen::MatrixXd basis;                     ///< [cos θ_R; sin θ_R] and their f-derivatives (θ_R = 2π f·R)
+    Eigen::MatrixXd values;                    ///< Energies and ∂ε/∂f per band
+};
+
+
+/// @brief Trigonometric (star-function) interpolation of every band on a periodic coarse grid
+/// @details The model is diagonalized once on the n1 x n2 x n3 grid k = Σ_d (m_d / n_d) b_d spanned by
+/// H.reciprocalBasis(). Each sorted band ε_n(k) is expanded as Σ_R c_nR exp(2πi f·R), with f the
+/// reduced coordinates of k and R running over the n1 x n2 x n3 lattice vectors closest to the origin;
+/// the expansion reproduces the coarse-grid energies exactly and is periodic and smooth everywhere.
+/// Since ε is real, c_{-R} = c_R* and only one R of each ±R pair is stored, as a cosine/sine
+/// series. Energies and group velocities ∇_k ε (analytic derivative of the series) then cost one
+/// small real matrix product per k-point, without calling Hamiltonian::eigensystem.
+/// The fit and the evaluation on a whole Monkhorst–Pack mesh (evaluateGrid) factorize into one
+/// transform per axis, so a dense point costs O(n1) per band instead of the O(n1 n2 n3) of evaluate.
+/// Convergence is spectral for isolated bands; at band crossings the sorted bands have kinks
+/// and need a denser coarse grid.
+class BandInterpolator {
+public:
+    /// @param H Hamiltonian model
+    /// @param n1 Coarse grid points along b1
+    /// @param n2 Coarse grid points along b2
+    /// @param n3 Coarse grid points along b3 (1 for 2D models)
+    BandInterpolator(const Hamiltonian& H, size_t n1, size_t n2, size_t n3 = 1);
+
+    /// @brief Number of interpolated bands
+    int numBands() const { return static_cast<int>(coefficients_.rows()); }
+
+    /// @brief Number of coarse-grid diagonalizations used to build the interpolant
+    size_t coarseSize() const { return n_[0] * n_[1] * n_[2]; }
+
+    /// @brief Interpolated energies and group velocities at k
+    /// @param k Wavevector (Cartesian)
+    /// @param ws Scratch buffers (one per thread; no allocations after the first call)
+    /// @param energies Output: band energies, ascending on the coarse grid
+    /// @param velocities Output: 3 x nbands matrix of ∂ε_n/∂k
+    void evaluate(const Eigen::Vector3d& k, InterpolationWorkspace& ws,
+                  Eigen::VectorXd& energies, Eigen::MatrixXd& velocities) const;
+
+    /// @brief Interpolated energies at k (convenience overload with a temporary workspace)
+    Eigen::VectorXd energies(const Eigen::Vector3d& k) const;
+
+    /// @brief Whether evaluateGrid accepts the mesh (Monkhorst–Pack mesh of the model's reciprocal basis)
+    bool supportsGrid(const Mesh& dense) const;
+
+    /// @brief Energies and group velocities at the points [begin, end) of a Monkhorst–Pack mesh
+    /// @details Evaluates the series plane by plane of the dense grid with separable transforms
+    /// (the zero-padded inverse of the fit), as matrix products; evaluate remains for off-grid points.
+    /// @param dense Mesh with supportsGrid(dense)
+    /// @param begin First mesh index
+    /// @param end One past the last mesh index
+    /// @param energies Output: (end - begin) x nbands
+    /// @param velocities Output: ∂ε/∂k_c for c = x, y, z, each (end - begin) x nbands
+    /// @throws std::invalid_argument if the mesh is not supported or the range exceeds it
+    void evaluateGrid(const Mesh& dense, size_t begin, size_t end,
+                      Eigen::MatrixXd& energies, std::array<Eigen::MatrixXd, 3>& velocities) const;
+
+private:
+    /// @brief Fill ws.basis with the cosine/sine series and its derivatives at k
+    void computeBasis(const Eigen::Vector3d& k, InterpolationWorkspace& ws) const;
+
+    std::array<size_t, 3> n_;                  ///< Coarse grid size per reciprocal axis
+    Eigen::Matrix3d basis_;                    ///< Reciprocal basis of the coarse grid
+    std::array<std::vector<int>, 3> axisR_;    ///< Lattice indices m used along each axis
+    std::vector<int> activeAxes_;              ///< Axes with more than one grid point
+    Eigen::Matrix3d reducedFromCartesian_;     ///< f = B⁻¹ k
+    Eigen::Matrix3d gradientToCartesian_;      ///< ∇_k = B⁻ᵀ ∇_f
+    Eigen::Matrix<int, 3, Eigen::Dynamic> R_;  ///< Position of each stored R in the axis tables
+    Eigen::Matrix3Xd Rreal_;                   ///< Stored lattice vectors R (one per ±R pair)
+    Eigen::MatrixXd coefficients_;             ///< [2 Re c_R, -2 Im c_R] per band (rows: bands), c_0 once
+    Eigen::MatrixXcd fourier_;                 ///< c_nR for all R: row R_1, column R_2 + m_2 (R_3 + m_3 n) (axis positions)
+};
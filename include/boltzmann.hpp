@@ -1,8 +1,14 @@
 #pragma once
 #include "hamiltonian.hpp"
+#include "two_band.hpp"
 #include "mesh.hpp"
 #include "geometry.hpp"
+#include "band_interpolation.hpp"
+#include "fermi_surface.hpp"
+#include "progress.hpp"
 #include <Eigen/Dense>
+#include <array>
+#include <vector>
 
 
 
@@ -14,6 +20,70 @@ struct VelocityResult {
 
 
 
+/// @brief Boltzmann transport coefficients at one (Ef, T)
+struct TransportCoefficients {
+    Eigen::Matrix3d sigma; ///< Conductivity σ_ij = ∫ Σ_ij(E) (-∂f/∂E) dE
+    Eigen::Matrix3d alpha; ///< Thermoelectric tensor α_ij = ∫ Σ_ij(E) (-∂f/∂E) (E-Ef)/T dE
+    Eigen::Matrix3d kappa; ///< Electronic thermal conductivity (L2 - L1 L0⁻¹ L1) / T (open circuit)
+};
+
+
+/// @brief Energy-resolved transport distribution Σ_ij(E) = τ Σ_nk w_k D_n v_i v_j δ(E - ε_nk)
+/// @details w_k are the mesh weights (Mesh::weights, normally summing to 1; 1/N on a uniform
+/// mesh), the same normalisation as computeTransportTensors. Computed once per mesh and field configuration by BoltzmannSolver::computeTransportDistribution.
+/// Σ(E) does not depend on Ef or T, so the coefficients for any (Ef, T) follow from a 1D
+/// thermal convolution over the energy grid without touching the mesh again.
+struct TransportDistribution {
+    std::vector<double> energies;        ///< Uniform energy grid
+    std::vector<Eigen::Matrix3d> sigma;  ///< Σ_ij(E) on the grid (per unit energy)
+    double dE = 0.0;                     ///< Grid spacing
+    bool temperature_in_kelvin = false;  ///< Copied from the solver: interpretation of T
+    double energy_scale = 1.0;           ///< Copied from the solver: energy unit for k_B T
+
+    /// @brief σ, α and κ at one Fermi energy and temperature
+    /// @param Ef Fermi energy
+    /// @param T Temperature (in Kelvin if temperature_in_kelvin is true)
+    TransportCoefficients coefficients(double Ef, double T) const;
+};
+
+
+
+/// @brief Second-order field expansion X(B) = X0 + Σ_c B_c X1[c] + Σ_cd B_c B_d X2[3c + d] of a transport tensor
+struct FieldExpansion {
+    Eigen::Matrix3d zero = Eigen::Matrix3d::Zero();
+    std::array<Eigen::Matrix3d, 3> linear = {Eigen::Matrix3d::Zero(), Eigen::Matrix3d::Zero(), Eigen::Matrix3d::Zero()};
+    std::array<Eigen::Matrix3d, 9> quadratic = {Eigen::Matrix3d::Zero(), Eigen::Matrix3d::Zero(), Eigen::Matrix3d::Zero(),
+                                                Eigen::Matrix3d::Zero(), Eigen::Matrix3d::Zero(), Eigen::Matrix3d::Zero(),
+                                                Eigen::Matrix3d::Zero(), Eigen::Matrix3d::Zero(), Eigen::Matrix3d::Zero()};
+
+    /// @brief Tensor at field B
+    Eigen::Matrix3d at(const Eigen::Vector3d& B) const;
+};
+
+
+/// @brief Orbital (Lorentz-force) magnetotransport in the Jones–Zener expansion
+/// @details Computed once per (Ef, T) by BoltzmannSolver::computeMagnetoTransport. For
+/// ḱ = -(E + v × B) the relaxation-time solution is σ_ij = τ Σ (-∂f/∂E) v_i [Σ_n (τ L)^n v]_j
+/// with L = (v × B)·∇_k. The expansion keeps n ≤ 2, i.e. ω_c τ ≪ 1, and the B² term is
+/// integrated by parts, -τ³ Σ (-∂f/∂E) (L v_i)(L v_j), so only band Hessians enter.
+/// Any number of fields is then evaluated from the stored coefficients.
+struct MagnetoTransport {
+    FieldExpansion sigma;   ///< σ(B): τ, τ² and τ³ terms
+    FieldExpansion alpha;   ///< α(B), same terms weighted by (E - Ef)/T
+    int dimension = 2;      ///< Mesh dimension: the in-plane 2x2 block is inverted for 2D
+
+    /// @brief Resistivity ρ(B) = σ(B)⁻¹ on the first dimension x dimension block (zero elsewhere)
+    Eigen::Matrix3d resistivity(const Eigen::Vector3d& B) const;
+
+    /// @brief Hall coefficient R_H = ρ_yx(B ẑ) / B
+    /// @param Bz Field along z; 0 gives the weak-field limit -(ρ0 σ1_z ρ0)_yx
+    double hallCoefficient(double Bz = 0.0) const;
+
+    /// @brief Magnetoresistance (ρ_ii(B) - ρ_ii(0)) / ρ_ii(0) along direction i
+    double magnetoresistance(const Eigen::Vector3d& B, int direction = 0) const;
+};
+
+
 ///  @file boltzmann.hpp
 ///  @brief BoltzmannSolver class for calculating transport properties with with optional quantum geometry effects
 class BoltzmannSolver {
@@ -27,7 +97,7 @@ public:
     BoltzmannSolver(const Hamiltonian& H, const Mesh& mesh, double tau,
                     bool temperature_in_kelvin = false,
                     double energy_scale = 1.0)
-        : H(H), mesh(mesh), tau(tau),
+        : H(H), two_band(dynamic_cast<const TwoBandModel*>(&H)), mesh(mesh), tau(tau),
           temperature_in_kelvin(temperature_in_kelvin),
           energy_scale(energy_scale) {}
 
@@ -46,6 +116,21 @@ public:
                             const Eigen::Vector3d& B, 
                             double dk = 1e-4) const;
 
+    /// @brief Semiclassical velocity of one state from its band velocity and Berry curvature
+    /// @details Adds the anomalous -E × Ω, Lorentz -(v × B) × Ω and ∇T terms and divides
+    /// by the phase-space factor D_n = 1 + B·Ω (reset to 1 if not positive).
+    static VelocityResult fieldVelocity(double energy, double Ef, double T,
+                                        const Eigen::Vector3d& v_group,
+                                        const Eigen::Vector3d& omega,
+                                        const Eigen::Vector3d& gradT,
+                                        const Eigen::Vector3d& E,
+                                        const Eigen::Vector3d& B);
+
+    /// @brief Add one state's contribution τ D_n (-∂f/∂E) v v^T to σ and (E-Ef)/T times it to α
+    /// @details The per-state kernel of every mesh path; D_n carries the k-point weight.
+    void accumulateState(double energy, double Ef, double T,
+                         const Eigen::Vector3d& v, double D_n,
+                         Eigen::Matrix3d& sigma, Eigen::Matrix3d& alpha) const;
     
     double phaseSpaceFactor(const Eigen::Vector3d& k, int band, 
                             const Eigen::Vector3d& B) const;
@@ -55,6 +140,8 @@ public:
     /// @param Ef: Fermi energy
     /// @param T: Temperature (in Kelvin if temperature_in_kelvin is true)
     /// @param Efield: Electric field vector
+    /// @param Bfield: Magnetic field vector, enters through the Berry-phase terms only
+    /// (the orbital Lorentz-force response is computeMagnetoTransport)
     /// @return tuble of conductivity tensor and thermopower tensor
 
     std::tuple<Eigen::Matrix3d, Eigen::Matrix3d> 
@@ -64,21 +151,155 @@ public:
                             const Eigen::Vector3d& Bfield) const;
 
 
+    /// @brief Conductivity and thermopower from interpolated bands on a dense mesh
+    /// @details Energies and group velocities come from the interpolant, so no eigensystem is
+    /// solved per dense k-point. Interpolated bands carry no Berry curvature: the anomalous,
+    /// Lorentz and ∇T velocity terms and the phase-space factor (D_n = 1) are omitted.
+    /// A Monkhorst–Pack mesh of the model's basis is evaluated in one pass (BandInterpolator::evaluateGrid).
+    /// @param bands Band interpolant of the same model
+    /// @param dense Dense k-point mesh to integrate over
+    /// @param Ef Fermi energy
+    /// @param T Temperature (in Kelvin if temperature_in_kelvin is true)
+    /// @return tuple of conductivity tensor and thermopower tensor
+    std::tuple<Eigen::Matrix3d, Eigen::Matrix3d>
+    computeTransportTensors(const BandInterpolator& bands, const Mesh& dense,
+                            double Ef, double T) const;
+
+
+    /// @brief Low-temperature σ and α as line integrals over the Fermi contours (2D models)
+    /// @details σ_ij = τ/A ∮ v_i v_j / |v| dl over the contours ε_n(k) = Ef in the reciprocal
+    /// unit cell of area A, i.e. the T → 0 limit of computeTransportTensors without fields.
+    /// α follows from the Mott formula α = (π²/3) (k_B T)²/T dσ(E)/dE at Ef, with the
+    /// derivative taken from the contours at Ef ± dE on the same grid.
+    /// The cost scales with the contour length instead of the mesh area; the solver's mesh is not used.
+    /// @param grid Band energies on the reciprocal unit cell (reusable for many Ef)
+    /// @param Ef Fermi energy
+    /// @param T Temperature (in Kelvin if temperature_in_kelvin is true), only enters α
+    /// @param dE Energy step of the Mott derivative
+    /// @return tuple of conductivity tensor and thermopower tensor
+    std::tuple<Eigen::Matrix3d, Eigen::Matrix3d>
+    computeFermiSurfaceTransport(const FermiSurfaceGrid& grid, double Ef, double T,
+                                 double dE = 1e-3) const;
+
+    /// @brief Fermi-contour transport on a fresh n x n grid (see the grid overload)
+    std::tuple<Eigen::Matrix3d, Eigen::Matrix3d>
+    computeFermiSurfaceTransport(double Ef, double T, size_t n, double dE = 1e-3) const;
+
+
+    /// @brief Tabulate the transport distribution Σ_ij(E) for fast Ef and T scans
+    /// @details Same band velocities (including anomalous and Lorentz terms) and phase-space
+    /// factor as computeTransportTensors, without the ∇T term, which depends on Ef and T.
+    /// Each state is deposited on the two nearest grid points with linear weights.
+    /// @param Emin Lower end of the energy grid
+    /// @param Emax Upper end of the energy grid (states outside [Emin, Emax] are dropped)
+    /// @param nE Number of grid points (at least 2)
+    /// @param Efield Electric field vector
+    /// @param Bfield Magnetic field vector
+    /// @return TransportDistribution evaluated with TransportDistribution::coefficients
+    TransportDistribution computeTransportDistribution(double Emin, double Emax, size_t nE,
+                                                       const Eigen::Vector3d& Efield,
+                                                       const Eigen::Vector3d& Bfield) const;
+
+
+    /// @brief Band Hessian ∂²ε_n/∂k_i∂k_j (inverse effective-mass tensor) at k
+    /// @details Second-order perturbation theory on one eigensystem of H(k), see bandHessians.
+    /// @param dk Step for differencing Hk or dHdk when the model has no analytic derivatives
     Eigen::Matrix3d secondDerivatives(const Eigen::Vector3d& k, int band, 
-                                      double dk) const;
+                                      double dk = 1e-4) const;
+
+    /// @brief Velocities and Hessians of all bands from one eigensystem of H(k)
+    /// @details ∂_i ε_n = <n|∂_i H|n> and
+    /// ∂_i ∂_j ε_n = <n|∂_i ∂_j H|n> + 2 Re Σ_{m≠n} <n|∂_i H|m><m|∂_j H|n> / (ε_n - ε_m),
+    /// with ∂H and ∂²H from Hamiltonian::dHdk and Hamiltonian::d2Hdk2 when available and
+    /// central differences of dHdk or Hk (no eigensolves) otherwise. Pairs closer than 1e-8
+    /// in energy are skipped, so Hessians inside degenerate subspaces are not resolved.
+    /// Only the first mesh.dimension() directions are filled.
+    /// @param eig Eigensystem of H(k)
+    /// @param velocities Filled with v_n in column n (3 x bands)
+    /// @param hessians Filled with one 3x3 Hessian per band
+    void bandHessians(const Eigen::Vector3d& k, const EigenWorkspace& eig, double dk,
+                      Eigen::MatrixXd& velocities, std::vector<Eigen::Matrix3d>& hessians) const;
+
+    /// @brief Lorentz-force σ(B) and α(B) to second order in B (see MagnetoTransport)
+    /// @details One eigensystem and one set of band Hessians per k-point that has a band
+    /// within 40 k_B T of Ef; the Berry-phase field terms of computeTransportTensors are not included.
+    /// @param Ef Fermi energy
+    /// @param T Temperature (in Kelvin if temperature_in_kelvin is true)
+    /// @param dk Step for differencing Hk or dHdk when the model has no analytic derivatives
+    MagnetoTransport computeMagnetoTransport(double Ef, double T, double dk = 1e-4) const;
+
+    /// @brief Report k-point progress to p during the following calls (nullptr disables)
+    /// @details The reporter is started with the rank-local k-point count, bumped once per
+    /// k-point and finished when the loop ends. It is not owned by the solver.
+    void setProgress(ProgressReporter* p) { progress = p; }
 
 
 private:
+    // Compile-time 2D/3D kernels; the public methods dispatch on mesh.dimension() once per call
+    template <int Dim>
+    VelocityResult velocityImpl(double energy, double Ef, double T,
+                                const Eigen::Vector3d& k, int band,
+                                const Eigen::Vector3d& gradT,
+                                const Eigen::Vector3d& E,
+                                const Eigen::Vector3d& B,
+                                double dk = 1e-4) const;
+
+    /// @brief Energies, group velocities and Ω_z of all bands at k, from one eigensystem
+    /// @details Fills eig_ws.evals, geom_velocities (3 x bands, first Dim rows) and geom_omega.
+    /// Two-band models use the closed forms of TwoBandModel::bandGeometry without any eigensystem.
+    /// Models with an analytic ∂H/∂k (Hamiltonian::dHdk) use Hellmann-Feynman v_i = <n|∂_i H|n>
+    /// and Ω_z = 2 Im Σ_m <n|∂_x H|m><m|∂_y H|n> / (E_n - E_m)² (the sign convention of
+    /// berryCurvatureFHS); with a band window (WindowedHamiltonian) that sum would be truncated,
+    /// so Ω_z comes from FHS plaquettes instead. Other models difference the band energies with
+    /// step dk and take Ω_z from one FHS plaquette shared by all bands.
+    template <int Dim>
+    void bandGeometryImpl(const Eigen::Vector3d& k, double dk = 1e-4) const;
+
+    template <int Dim>
+    TransportDistribution computeTransportDistributionImpl(double Emin, double Emax, size_t nE,
+                                                           const Eigen::Vector3d& Efield,
+                                                           const Eigen::Vector3d& Bfield) const;
+
+    template <int Dim>
+    void bandHessiansImpl(const Eigen::Vector3d& k, const EigenWorkspace& eig, double dk,
+                          Eigen::MatrixXd& velocities, std::vector<Eigen::Matrix3d>& hessians) const;
+
+    /// @brief ∂H/∂k_i from Hamiltonian::dHdk, or by central differences of Hk
+    void firstDerivativeH(const Eigen::Vector3d& k, int i, double dk, Eigen::MatrixXcd& out) const;
+
+    /// @brief ∂²H/∂k_i∂k_j from Hamiltonian::d2Hdk2, or by central differences of firstDerivativeH
+    void secondDerivativeH(const Eigen::Vector3d& k, int i, int j, double dk, Eigen::MatrixXcd& out) const;
+
+    template <int Dim>
+    MagnetoTransport computeMagnetoTransportImpl(double Ef, double T, double dk) const;
+
+    template <int Dim>
+    std::tuple<Eigen::Matrix3d, Eigen::Matrix3d>
+    computeTransportTensorsImpl(double Ef, double T,
+                                const Eigen::Vector3d& gradT,
+                                const Eigen::Vector3d& Efield,
+                                const Eigen::Vector3d& Bfield) const;
+
     const Hamiltonian& H;
+    const TwoBandModel* two_band; ///< H as a TwoBandModel (closed-form v and Ω), nullptr otherwise
     const Mesh& mesh;
     double tau;
     bool temperature_in_kelvin;
     double energy_scale;
 
     // Reusable buffers to avoid allocations
-    mutable Eigen::VectorXd evals_plus;
-    mutable Eigen::VectorXd evals_minus;
-    mutable Eigen::MatrixXcd evecs_dummy;
-    mutable Eigen::VectorXd evals;
-    mutable Eigen::MatrixXcd evecs;
+    mutable EigenWorkspace ws_plus;
+    mutable EigenWorkspace ws_minus;
+    mutable EigenWorkspace eig_ws;
+    mutable BerryWorkspace berry_ws;
+    mutable InterpolationWorkspace interp_ws;
+    mutable Eigen::VectorXd interp_energies;
+    mutable Eigen::MatrixXd interp_velocities;
+    mutable std::array<Eigen::MatrixXcd, 3> dH_analytic, dH_eigenbasis;
+    mutable Eigen::MatrixXcd d2H_buffer, dH_plus, dH_minus, dH_product;
+    mutable Eigen::MatrixXd hess_velocities;
+    mutable Eigen::MatrixXd geom_velocities; ///< bandGeometryImpl: v_n in column n
+    mutable Eigen::VectorXd geom_omega;      ///< bandGeometryImpl: Ω_z per band
+    mutable std::vector<Eigen::Matrix3d> hess_buffer;
+    ProgressReporter* progress = nullptr;
 };
@@ -0,0 +1,100 @@
+#pragma once
+#include "hamiltonian.hpp"
+#include "mesh.hpp"
+#include <Eigen/Dense>
+#include <functional>
+#include <initializer_list>
+#include <iosfwd>
+#include <vector>
+
+/// @file convergence.hpp
+/// @brief Automatic k-mesh convergence with nested grids and Richardson extrapolation
+/// @details A quantity Q that is a weighted k-average (σ, α, DOS, ...) is evaluated on
+/// Γ-centred Monkhorst–Pack meshes of n, 2n, 4n, ... points per axis. These grids nest,
+/// so each refinement only evaluates the points the finer grid adds and combines them
+/// with the previous average: Q_2n = 2^-d Q_n + (1 - 2^-d) Q_new. Successive levels are
+/// Richardson-extrapolated for an error ~ h^p (p = order, or the observed order when the
+/// differences shrink faster), and the refinement stops once the error estimate of the
+/// selected components is below the tolerance.
+
+/// @brief Settings for MeshConvergence
+struct ConvergenceOptions {
+    size_t initialPoints = 16;      ///< Points per axis of the first mesh
+    size_t maxLevels = 6;           ///< Number of meshes at most (initialPoints * 2^(maxLevels-1) per axis)
+    double tolerance = 1e-4;        ///< Target error of the selected components
+    bool relative = true;           ///< Tolerance relative to max |Q| of the selected components
+    double order = 2.0;             ///< Minimum convergence order p assumed for the error ~ h^p
+    bool extrapolate = true;        ///< Report the Richardson extrapolant instead of the finest mesh value
+    std::vector<int> components;    ///< Indices of Q checked against the tolerance (empty: all)
+};
+
+/// @brief One refinement step
+struct ConvergenceLevel {
+    size_t pointsPerAxis = 0;       ///< n of the n^d mesh
+    size_t newPoints = 0;           ///< k-points evaluated at this level
+    Eigen::VectorXd value;          ///< Mesh average on the n^d mesh
+    Eigen::VectorXd extrapolated;   ///< Richardson extrapolant from this and the previous level
+    double errorEstimate = 0.0;     ///< Estimated error |Q_n - Q_∞| of the selected components
+};
+
+/// @brief Converged (or best available) result
+struct ConvergenceResult {
+    Eigen::VectorXd value;          ///< Extrapolated (or finest mesh) value
+    Eigen::VectorXd finestMesh;     ///< Value on the finest mesh
+    double errorEstimate = 0.0;     ///< Estimated error of value (absolute)
+    size_t pointsPerAxis = 0;       ///< Finest mesh used
+    size_t totalPoints = 0;         ///< k-points evaluated over all levels
+    bool converged = false;
+    std::vector<ConvergenceLevel> history;
+};
+
+/// @brief Refinement driver over nested Monkhorst–Pack meshes of one reciprocal cell
+class MeshConvergence {
+public:
+    /// @brief Mesh average of the quantities of interest, flattened into a vector
+    /// @details Called with the k-points a level adds; must return Σ_k w_k Q(k) for the
+    /// mesh's weights (every solver does), with the same vector length on each call.
+    using Evaluator = std::function<Eigen::VectorXd(const Mesh&)>;
+
+    /// @param basis Reciprocal lattice vectors (columns), e.g. H.reciprocalBasis()
+    /// @param dimension 2 (b1, b2 refined) or 3 (b1, b2, b3 refined)
+    /// @param options Tolerance, levels and extrapolation settings
+    MeshConvergence(const Eigen::Matrix3d& basis, int dimension = 2,
+                    const ConvergenceOptions& options = ConvergenceOptions());
+
+    /// @brief Refine until converged or maxLevels is reached
+    ConvergenceResult run(const Evaluator& evaluate) const;
+
+    /// @brief Points of the n-per-axis mesh that the n/2 mesh does not contain (all points for the first level)
+    /// @details Weights are uniform over the returned points and sum to 1.
+    Mesh refinementPoints(size_t n, bool first) const;
+
+private:
+    Eigen::Matrix3d basis;
+    int dimension;
+    ConvergenceOptions options;
+};
+
+/// @brief Flatten 3x3 tensors (column-major, one after the other) for an Evaluator
+Eigen::VectorXd flattenTensors(std::initializer_list<Eigen::Matrix3d> tensors);
+
+/// @brief Converged Kubo σ and α: value = [σ (9), α (9)], column-major
+/// @details κ is not linear in the k-average and is left out.
+/// @param dimension 2 (meshes in the b1-b2 plane) or 3 (b1, b2 and b3 refined), as MeshConvergence
+ConvergenceResult convergeKubo(const Hamiltonian& H, double eta, double Ef, double T, int dimension = 2,
+                               const ConvergenceOptions& options = ConvergenceOptions());
+
+/// @brief Converged Boltzmann σ and α: value = [σ (9), α (9)], column-major
+/// @param dimension 2 or 3, as convergeKubo
+ConvergenceResult convergeBoltzmann(const Hamiltonian& H, double tau, double Ef, double T,
+                                    const Eigen::Vector3d& gradT, const Eigen::Vector3d& Efield,
+                                    const Eigen::Vector3d& Bfield, int dimension = 2,
+                                    const ConvergenceOptions& options = ConvergenceOptions());
+
+/// @brief Converged Gaussian-smeared DOS on the DOS::computeDOS energy grid
+/// @param dimension 2 or 3, as convergeKubo
+ConvergenceResult convergeDOS(const Hamiltonian& H, double Emin, double Emax, int nBins, double sigma,
+                              int dimension = 2, const ConvergenceOptions& options = ConvergenceOptions());
+
+/// @brief Print the refinement history and the final estimate
+std::ostream& operator<<(std::ostream& os, const ConvergenceResult& result);
@@ -0,0 +1,50 @@
+#pragma once
+#include <Eigen/Dense>
+#include <complex>
+#include <cstddef>
+#include <utility>
+
+/// @file distributed.hpp
+/// @brief Optional MPI decomposition of k-point loops
+/// @details When the library is built with QT_ENABLE_MPI and the caller has initialised MPI,
+/// every solver sums over its rank-local block of the mesh and the partial results are
+/// combined with an allreduce, so all ranks return the full tensors.
+/// Without MPI (or before MPI_Init) all functions describe a single process.
+namespace Distributed {
+
+    /// @brief True if the library was built with MPI, MPI is initialised and no SerialScope is alive
+    bool active();
+
+    /// @brief While alive, this process acts as a single rank
+    /// @details Solvers then sum the whole mesh locally and skip the reductions, e.g. to compute
+    /// a serial reference on one rank. Scopes nest; create them outside parallel regions.
+    class SerialScope {
+    public:
+        SerialScope();
+        ~SerialScope();
+        SerialScope(const SerialScope&) = delete;
+        SerialScope& operator=(const SerialScope&) = delete;
+    };
+
+    /// @brief Rank of this process in MPI_COMM_WORLD (0 without MPI)
+    int rank();
+
+    /// @brief Number of processes in MPI_COMM_WORLD (1 without MPI)
+    int size();
+
+    /// @brief Contiguous block [begin, end) of n items owned by this rank
+    std::pair<size_t, size_t> localRange(size_t n);
+
+    /// @brief In-place sum of a buffer over all ranks
+    void sumAll(double* data, size_t count);
+
+    /// @brief In-place sum of a complex buffer over all ranks
+    void sumAll(std::complex<double>* data, size_t count);
+
+    /// @brief In-place sum of a dense Eigen object over all ranks
+    template <typename Derived>
+    void sumAll(Eigen::PlainObjectBase<Derived>& m) {
+        sumAll(m.data(), static_cast<size_t>(m.size()));
+    }
+
+} // namespace Distributed
@@ -1,6 +1,7 @@
 #pragma once
 #include "hamiltonian.hpp"
 #include "mesh.hpp"
+#include "progress.hpp"
 #include <vector>
 
 /// @brief Density of States (DOS) calculator for solid-state systems
@@ -25,10 +26,16 @@ public:
     std::vector<double> computeProjectedDOS(double E_min, double E_max, int N_bins, double eta, int orbital_index);
     /// @brief Get the energy grid used for the DOS histogram
     const std::vector<double>& getEnergyGrid() const; 
+
+    /// @brief Report k-point progress to p during the following calls (nullptr disables)
+    /// @details The reporter is started with the mesh count, bumped once per
+    /// k-point and finished when the loop ends. It is not owned by the solver.
+    void setProgress(ProgressReporter* p) { progress = p; }
    
 private:
     const Hamiltonian& H;
     const Mesh& mesh;
     std::vector<double> energy_grid_; // Energies for the histogram
+    ProgressReporter* progress = nullptr;
 
 };
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+#include "hamiltonian.hpp"
+#include <Eigen/Dense>
+#include <vector>
+
+/// @file fermi_surface.hpp
+/// @brief Constant-energy contours of 2D band structures by marching squares
+/// @details Band energies are tabulated once on a coarse periodic grid spanned by the
+/// first two reciprocal lattice vectors (Hamiltonian::reciprocalBasis). For any energy E
+/// the contours ε_n(k) = E are traced cell by cell, every edge crossing is refined with
+/// exact eigenvalues along the edge, and the band velocity is evaluated there, so line
+/// integrals over the Fermi surface cost O(number of crossings) eigensolves.
+
+/// @brief Point on a contour with its band velocity v = ∇_k ε_n
+struct FermiPoint {
+    Eigen::Vector3d k;
+    Eigen::Vector3d v;
+};
+
+/// @brief Straight piece of a contour inside one grid cell
+struct FermiSegment {
+    int band;
+    FermiPoint a, b;
+};
+
+/// @brief All contours ε_n(k) = energy in one reciprocal unit cell
+struct FermiSurface {
+    double energy = 0.0;
+    double cellArea = 0.0;                ///< Area of the reciprocal unit cell |b1 × b2|
+    std::vector<FermiSegment> segments;
+
+    /// @brief Total contour length (of one band, or of all bands if band < 0)
+    double length(int band = -1) const;
+
+    /// @brief ∮ v v^T / |v| dl over the contours (trapezoidal rule on each segment)
+    /// @details Divided by cellArea this is the T → 0 limit of ⟨(-∂f/∂E) v v^T⟩_BZ.
+    Eigen::Matrix3d velocityIntegral() const;
+};
+
+/// @brief Band energies on a periodic n1 x n2 grid of the reciprocal unit cell (2D models)
+class FermiSurfaceGrid {
+public:
+    /// @param H Model (must outlive the grid)
+    /// @param n1 Grid points along b1
+    /// @param n2 Grid points along b2 (n1 if 0)
+    FermiSurfaceGrid(const Hamiltonian& H, size_t n1, size_t n2 = 0);
+
+    /// @brief Trace, refine and attach velocities to all contours at energy E
+    /// @param tolerance Energy tolerance of the edge-crossing refinement
+    FermiSurface contours(double E, double tolerance = 1e-12) const;
+
+    size_t n1() const { return n1_; }
+    size_t n2() const { return n2_; }
+    int numBands() const { return static_cast<int>(energies_.rows()); }
+
+    /// @brief Area of the reciprocal unit cell |b1 × b2|
+    double cellArea() const { return cellArea_; }
+
+private:
+    /// @brief Cartesian k of fractional coordinates (f1, f2)
+    Eigen::Vector3d cartesian(double f1, double f2) const;
+
+    /// @brief Energy of band n at grid point (i mod n1, j mod n2)
+    double energy(int band, long i, long j) const;
+
+    const Hamiltonian& H;
+    size_t n1_, n2_;
+    Eigen::Vector3d b1_, b2_;
+    double cellArea_;
+    Eigen::MatrixXd energies_;  ///< bands x (n1 * n2), point (i, j) in column i * n2 + j
+};
@@ -1,50 +1,109 @@
 #pragma once
 #include "hamiltonian.hpp"
+#include "two_band.hpp"
 #include <Eigen/Dense>
+#include <array>
 #include <complex>
 #include <cmath>
+#include <vector>
 
-// Reusable buffer to avoid repeated allocations
-namespace BerryCurvature {
-    thread_local static Eigen::MatrixXcd u0, ux, uy, uxy;
-    thread_local static Eigen::VectorXd evals;
-    thread_local static Eigen::MatrixXcd H_plus2, H_plus1, H_minus1, H_minus2;
+
+/// @brief Caller-owned scratch buffers for the Berry-curvature routines
+/// @details Holds the plaquette eigensystems and the finite-difference Hamiltonians.
+/// A workspace is not shared between threads: give every worker its own instance
+/// and reuse it across k-points so the buffers are only allocated once.
+struct BerryWorkspace {
+    EigenWorkspace e0, ex, ey, exy;     ///< Eigensystems at the plaquette corners k, k+dx, k+dy, k+dx+dy
+    Eigen::MatrixXcd H_plus2, H_plus1, H_minus1, H_minus2; ///< Finite-difference stencil
+    Eigen::MatrixXcd dHdkx, dHdky;      ///< ∂H/∂kx and ∂H/∂ky
+    Eigen::MatrixXcd dH, product;       ///< ∂H/∂k_i and ∂H/∂k_i U for the velocity matrices
+    std::array<Eigen::MatrixXcd, 3> velocities; ///< <n|∂_i H|m> in the eigenbasis of e0
+};
+
+
+/**
+ * @brief Numerically approximate ∂H/∂k_direction using a 4th-order central difference
+ * @param H Hamiltonian object
+ * @param k Wavevector (k-point) in reciprocal space
+ * @param direction Cartesian direction (0, 1, 2)
+ * @param dk Finite-difference step
+ * @param ws Workspace holding the stencil buffers
+ * @param out Result ∂H/∂k_direction
+ */
+inline void dHdk(const Hamiltonian& H, const Eigen::Vector3d& k,
+                 int direction, double dk, BerryWorkspace& ws, Eigen::MatrixXcd& out) {
+
+    Eigen::Vector3d dk_vec = Eigen::Vector3d::Zero();
+    dk_vec(direction) = dk;
+
+    // Central difference with 4th-order accuracy
+    H.Hk(k + 2.0 * dk_vec, ws.H_plus2);
+    H.Hk(k + dk_vec, ws.H_plus1);
+    H.Hk(k - dk_vec, ws.H_minus1);
+    H.Hk(k - 2.0 * dk_vec, ws.H_minus2);
+
+    out = (-ws.H_plus2 + 8.0 * ws.H_plus1 - 8.0 * ws.H_minus1 + ws.H_minus2) / (12.0 * dk);
 }
 
-    
+/// @brief Convenience overload of dHdk with a temporary workspace
+inline Eigen::MatrixXcd dHdk(const Hamiltonian& H, const Eigen::Vector3d& k,
+                            int direction, double dk) {
+    BerryWorkspace ws;
+    Eigen::MatrixXcd out;
+    dHdk(H, k, direction, dk, ws, out);
+    return out;
+}
+
+
+/// @brief Closed-form Berry curvature of all bands if H is a TwoBandModel
+/// @return false (omega untouched) for any other model
+inline bool twoBandCurvature(const Hamiltonian& H, const Eigen::Vector3d& k, Eigen::VectorXd& omega) {
+    const auto* two_band = dynamic_cast<const TwoBandModel*>(&H);
+    if (!two_band) return false;
+    TwoBandGeometry geometry;
+    two_band->bandGeometry(k, geometry);
+    omega = geometry.omega;
+    return true;
+}
 
 
 /**
  * @brief Calculate the Berry curvature at a given k-point using the Fukui-Hatsugai-Suzuki discretized formula
+ * @details Ω = arg(U1 U2 U3 U4) / dk² around the plaquette k, k+dx, k+dx+dy, k+dy. This is the sign
+ * convention of every Berry curvature in this library (berryCurvatureDifferential, the quantum
+ * geometric tensor, BoltzmannSolver): Ω_z = 2 Im Σ_{m≠n} <n|∂_x H|m><m|∂_y H|n> / (E_n - E_m)²,
+ * i.e. Ω = ∇ × A for A = -i<u|∇u>, the opposite of the A = i<u|∇u> convention.
+ * Two-band models (TwoBandModel) return their closed-form Ω at k instead; dk is then unused.
  * @param H Hamiltonian object (must implement eigensystem)
  * @param k Wavevector (k-point) in reciprocal space
  * @param dk Small displacement in k-space
  * @param band_index Index of the band to compute curvature for
+ * @param ws Caller-owned workspace (one per thread)
  * @return Berry curvature at the specified k-point
  */
-inline double berryCurvatureFHS(const Hamiltonian& H, 
-    const Eigen::Vector3d& k, double dk = 1e-3, int band_index = 0) {
-        
-    using namespace BerryCurvature;
-    
+inline double berryCurvatureFHS(const Hamiltonian& H, const Eigen::Vector3d& k,
+                                double dk, int band_index, BerryWorkspace& ws) {
+
+    if (const auto* two_band = dynamic_cast<const TwoBandModel*>(&H)) {
+        TwoBandGeometry geometry;
+        two_band->bandGeometry(k, geometry);
+        return geometry.omega(band_index);
+    }
+
     const Eigen::Vector3d dkx(dk, 0, 0);
     const Eigen::Vector3d dky(0, dk, 0);
     const Eigen::Vector3d dkxy(dk, dk, 0);
 
-
-    //Eigen::MatrixXcd u0, ux, uy, uxy;
-    //Eigen::VectorXd evals;
-
     // Eigenstates at the four corners of the plaquette
-    H.eigensystem(k, evals, u0);
-    H.eigensystem(k + dkx, evals, ux);
-    H.eigensystem(k + dkxy, evals, uxy);
-    H.eigensystem(k + dky, evals, uy);
+    H.eigensystem(k, ws.e0);
+    H.eigensystem(k + dkx, ws.ex);
+    H.eigensystem(k + dkxy, ws.exy);
+    H.eigensystem(k + dky, ws.ey);
 
-    //auto overlap = [](const Eigen::VectorXcd& a, const Eigen::VectorXcd& b) {
-    //    double norm = a.norm() * b.norm();
-    //    return (norm < 1e-10) ? 0.0 : (a.adjoint() * b)(0);
-    //};
+    const Eigen::MatrixXcd& u0 = ws.e0.evecs;
+    const Eigen::MatrixXcd& ux = ws.ex.evecs;
+    const Eigen::MatrixXcd& uy = ws.ey.evecs;
+    const Eigen::MatrixXcd& uxy = ws.exy.evecs;
 
     // Link variables (complex overlaps)
     const std::complex<double> U1 = u0.col(band_index).adjoint() * ux.col(band_index);
@@ -52,68 +111,116 @@ inline double berryCurvatureFHS(const Hamiltonian& H,
     const std::complex<double> U3 = uxy.col(band_index).adjoint() * uy.col(band_index);
     const std::complex<double> U4 = uy.col(band_index).adjoint() * u0.col(band_index);
 
-    
     const double product_magnitude = std::abs(U1 * U2 * U3 * U4);
     if (product_magnitude < 1e-12) return 0.0;
 
-
     double phase = std::arg(U1 * U2 * U3 * U4);
     phase = std::remainder(phase, 2 * M_PI);  // Ensure phase ∈ [-π, π]
 
     return phase / (dk * dk);
-    
 }
 
+/// @brief FHS Berry curvature with a temporary workspace (see the workspace overload)
+inline double berryCurvatureFHS(const Hamiltonian& H,
+    const Eigen::Vector3d& k, double dk = 1e-3, int band_index = 0) {
+    BerryWorkspace ws;
+    return berryCurvatureFHS(H, k, dk, band_index, ws);
+}
 
 
-/// Numerically approximate ∂H/∂kx and ∂H/∂ky using finite difference
-//inline Eigen::MatrixXcd dHdk(const Hamiltonian& H, const Eigen::Vector3d& k, int direction, double dk) {
-//    using Vec = Eigen::Vector3d;
-//    Eigen::MatrixXcd H_plus = H.Hk(k + dk * Vec(direction == 0, direction == 1, 0));
-//    Eigen::MatrixXcd H_minus = H.Hk(k - dk * Vec(direction == 0, direction == 1, 0));
-//    return (H_plus - H_minus) / (2.0 * dk);
-//}
+/**
+ * @brief FHS Berry curvature of all bands at one k-point from a single plaquette
+ * @details The four corner diagonalizations are shared between the bands. Two-band models
+ * return their closed-form Ω at k (see berryCurvatureFHS).
+ * @param H Hamiltonian object
+ * @param k Wavevector (k-point) in reciprocal space
+ * @param dk Plaquette size
+ * @param ws Caller-owned workspace (one per thread)
+ * @param omega Output: Berry curvature per band
+ */
+inline void berryCurvatureFHSAllBands(const Hamiltonian& H, const Eigen::Vector3d& k,
+                                      double dk, BerryWorkspace& ws, Eigen::VectorXd& omega) {
 
-inline Eigen::MatrixXcd dHdk(const Hamiltonian& H, const Eigen::Vector3d& k, 
-                            int direction, double dk) {
+    if (twoBandCurvature(H, k, omega)) return;
 
-    using namespace BerryCurvature;
-    
-    Eigen::Vector3d dk_vec = Eigen::Vector3d::Zero();
-    dk_vec(direction) = dk;
-    
-    // Central difference with 4th-order accuracy
-    H_plus2 = H.Hk(k + 2.0 * dk_vec);
-    H_plus1 = H.Hk(k + dk_vec);
-    H_minus1 = H.Hk(k - dk_vec);
-    H_minus2 = H.Hk(k - 2.0 * dk_vec);
-    
-    return (-H_plus2 + 8.0 * H_plus1 - 8.0 * H_minus1 + H_minus2) / (12.0 * dk);
+    const Eigen::Vector3d dkx(dk, 0, 0);
+    const Eigen::Vector3d dky(0, dk, 0);
+    const Eigen::Vector3d dkxy(dk, dk, 0);
+
+    H.eigensystem(k, ws.e0);
+    H.eigensystem(k + dkx, ws.ex);
+    H.eigensystem(k + dkxy, ws.exy);
+    H.eigensystem(k + dky, ws.ey);
+
+    const Eigen::MatrixXcd& u0 = ws.e0.evecs;
+    const Eigen::MatrixXcd& ux = ws.ex.evecs;
+    const Eigen::MatrixXcd& uy = ws.ey.evecs;
+    const Eigen::MatrixXcd& uxy = ws.exy.evecs;
+
+    const int nbands = static_cast<int>(u0.cols());
+    omega.resize(nbands);
+
+    for (int n = 0; n < nbands; ++n) {
+        const std::complex<double> U1 = u0.col(n).adjoint() * ux.col(n);
+        const std::complex<double> U2 = ux.col(n).adjoint() * uxy.col(n);
+        const std::complex<double> U3 = uxy.col(n).adjoint() * uy.col(n);
+        const std::complex<double> U4 = uy.col(n).adjoint() * u0.col(n);
+
+        const std::complex<double> product = U1 * U2 * U3 * U4;
+        if (std::abs(product) < 1e-12) {
+            omega(n) = 0.0;
+            continue;
+        }
+        omega(n) = std::remainder(std::arg(product), 2 * M_PI) / (dk * dk);
+    }
 }
 
+
+/**
+ * @brief Batched FHS Berry curvature over many k-points and all bands
+ * @details Closed form for two-band models, as berryCurvatureFHSAllBands.
+ * @param H Hamiltonian object
+ * @param kpoints List of k-points (e.g. mesh.getKPoints() or a slice of it)
+ * @param dk Plaquette size
+ * @param ws Caller-owned workspace (one per thread)
+ * @return Matrix of size (number of k-points) x (number of bands)
+ */
+inline Eigen::MatrixXd berryCurvatureBatch(const Hamiltonian& H,
+                                           const std::vector<Eigen::Vector3d>& kpoints,
+                                           double dk, BerryWorkspace& ws) {
+    Eigen::MatrixXd curvature;
+    Eigen::VectorXd omega;
+
+    for (size_t ik = 0; ik < kpoints.size(); ++ik) {
+        berryCurvatureFHSAllBands(H, kpoints[ik], dk, ws, omega);
+        if (ik == 0) curvature.resize(static_cast<Eigen::Index>(kpoints.size()), omega.size());
+        curvature.row(static_cast<Eigen::Index>(ik)) = omega.transpose();
+    }
+    return curvature;
+}
+
+
 /**
  * @brief Calculate the Berry curvature at a given k-point using the differential method
+ * @details Ω_z = 2 Im Σ_{m≠n} <n|∂_x H|m><m|∂_y H|n> / (E_n - E_m)², the sign of berryCurvatureFHS,
+ * with ∂H from finite differences, nearly degenerate partners skipped and the result clamped to ±100.
  * @param H Hamiltonian object (must implement eigensystem)
  * @param k Wavevector (k-point) in reciprocal space
  * @param dk Small displacement in k-space
  * @param band_index Index of the band to compute curvature for
+ * @param ws Caller-owned workspace (one per thread)
  * @return Berry curvature at the specified k-point
  */
-inline double berryCurvatureDifferential(const Hamiltonian& H, 
-                                        const Eigen::Vector3d& k,  
-                                        double dk = 1e-3, 
-                                        int band_index = 0) {
-
-    using namespace BerryCurvature;
+inline double berryCurvatureDifferential(const Hamiltonian& H, const Eigen::Vector3d& k,
+                                         double dk, int band_index, BerryWorkspace& ws) {
 
-    //Eigen::VectorXd evals;
-    //Eigen::MatrixXcd evecs;
-
-    H.eigensystem(k, evals, u0); // using u0 as a reusable buffer
+    H.eigensystem(k, ws.e0);
+    const Eigen::MatrixXcd& u0 = ws.e0.evecs;
+    const Eigen::VectorXd& evals = ws.e0.evals;
 
     // Compute numerical derivatives ∂H/∂kx and ∂H/∂ky
-    Eigen::MatrixXcd dHdkx = dHdk(H, k, 0, dk);
-    Eigen::MatrixXcd dHdky = dHdk(H, k, 1, dk);
+    dHdk(H, k, 0, dk, ws, ws.dHdkx);
+    dHdk(H, k, 1, dk, ws, ws.dHdky);
 
     std::complex<double> omega = 0.0;
     const auto& u_n = u0.col(band_index);
@@ -127,24 +234,162 @@ inline double berryCurvatureDifferential(const Hamiltonian& H,
 
         if (std::abs(deltaE) < 1e-8) continue;  // skip nearly degenerate bands
 
+        const std::complex<double> vx_nm = u_n.adjoint() * ws.dHdkx * u0.col(m);
+        const std::complex<double> vy_mn = u0.col(m).adjoint() * ws.dHdky * u_n;
 
-        const std::complex<double> vx_nm = u_n.adjoint() * dHdkx * u0.col(m);
-        const std::complex<double> vy_mn = u0.col(m).adjoint() * dHdky * u_n;
-
-        
-        //double epsi = 1e-6;  // small positive number to avoid division by zero
-        //double denom = std::pow(E_n - E_m, 2) + epsi;  // ε = 1e-6 or smaller
-        omega += vx_nm * vy_mn / (deltaE * deltaE); // Use complex division
+        omega += vx_nm * vy_mn / (deltaE * deltaE);
     }
- 
 
-    double curvature = -2.0 * std::imag(omega);
+    double curvature = 2.0 * std::imag(omega);
 
     const double BMAX = 1e2;
     if (curvature < -BMAX) curvature = -BMAX;
     if (curvature >  BMAX) curvature =  BMAX;
-    
+
     return curvature;
+}
 
-    
+/// @brief Differential Berry curvature with a temporary workspace (see the workspace overload)
+inline double berryCurvatureDifferential(const Hamiltonian& H,
+                                        const Eigen::Vector3d& k,
+                                        double dk = 1e-3,
+                                        int band_index = 0) {
+    BerryWorkspace ws;
+    return berryCurvatureDifferential(H, k, dk, band_index, ws);
+}
+
+
+/// @brief Quantum geometric tensor of every band at one k-point
+/// @details Q^n_ij = Σ_{m≠n} <n|∂_i H|m><m|∂_j H|n> / (E_n - E_m)², whose real part is the
+/// quantum metric and whose imaginary part the Berry curvature. Pairs closer than 1e-8 in
+/// energy are skipped, so for degenerate bands only the geometry relative to the other
+/// bands is resolved (as in the other sum-over-states formulas of this file).
+struct QuantumGeometricTensor {
+    std::vector<Eigen::Matrix3cd> Q; ///< Q^n, one Hermitian 3x3 matrix per band
+
+    int bands() const { return static_cast<int>(Q.size()); }
+
+    /// @brief Quantum metric g^n_ij = Re Q^n_ij
+    Eigen::Matrix3d metric(int n) const { return Q[n].real(); }
+
+    /// @brief Berry curvature vector Ω^n_c = ε_cij Im Q^n_ij, e.g. Ω_z = 2 Im Q_xy (berryCurvatureFHS sign)
+    Eigen::Vector3d curvature(int n) const {
+        return 2.0 * Eigen::Vector3d(Q[n](1, 2).imag(), Q[n](2, 0).imag(), Q[n](0, 1).imag());
+    }
+};
+
+
+/// @brief Quantum metric and Berry curvature of all bands on a list of k-points
+/// @details Row ik holds k-point ik; band n occupies columns 6n..6n+5 of metric
+/// (g_xx, g_yy, g_zz, g_xy, g_xz, g_yz) and columns 3n..3n+2 of curvature (Ω_x, Ω_y, Ω_z).
+struct QuantumGeometryMap {
+    Eigen::MatrixXd metric;     ///< (number of k-points) x (6 x bands)
+    Eigen::MatrixXd curvature;  ///< (number of k-points) x (3 x bands)
+
+    /// @brief Write the tensor of every band at one k-point into row ik
+    void store(Eigen::Index ik, const QuantumGeometricTensor& qgt) {
+        for (int n = 0; n < qgt.bands(); ++n) {
+            const Eigen::Matrix3d g = qgt.metric(n);
+            metric.block<1, 6>(ik, 6 * n) << g(0, 0), g(1, 1), g(2, 2), g(0, 1), g(0, 2), g(1, 2);
+            curvature.block<1, 3>(ik, 3 * n) = qgt.curvature(n).transpose();
+        }
+    }
+
+    /// @brief Quantum metric g^n_ij at k-point ik
+    Eigen::Matrix3d metricAt(Eigen::Index ik, int n) const {
+        const auto c = metric.block<1, 6>(ik, 6 * n);
+        Eigen::Matrix3d g;
+        g << c(0), c(3), c(4),
+             c(3), c(1), c(5),
+             c(4), c(5), c(2);
+        return g;
+    }
+
+    /// @brief Berry curvature vector Ω^n at k-point ik
+    Eigen::Vector3d curvatureAt(Eigen::Index ik, int n) const {
+        return curvature.block<1, 3>(ik, 3 * n).transpose();
+    }
+};
+
+
+/**
+ * @brief Quantum geometric tensor of all bands from one eigensystem and its velocity matrices
+ * @details For each band n, with A_im = <n|∂_i H|m> and w_m = 1/(E_n - E_m)², Q^n = A diag(w) A^†:
+ * O(N²) per k-point on top of the diagonalization, the cost of one Kubo step.
+ * @param evals Eigenvalues at k (ascending)
+ * @param velocities <n|∂_i H|m> in the eigenbasis (as BandChunk::velocities); entries i >= dimension are not read
+ * @param dimension Number of k-directions with velocity matrices (Q_ij = 0 if i or j >= dimension)
+ * @param out Receives Q^n for every band (storage is reused between calls)
+ */
+inline void quantumGeometricTensor(const Eigen::VectorXd& evals,
+                                   const std::array<Eigen::MatrixXcd, 3>& velocities,
+                                   int dimension, QuantumGeometricTensor& out) {
+    const Eigen::Index nb = evals.size();
+    out.Q.resize(static_cast<size_t>(nb));
+
+    for (Eigen::Index n = 0; n < nb; ++n) {
+        Eigen::Matrix3cd& Q = out.Q[static_cast<size_t>(n)];
+        Q.setZero();
+        for (Eigen::Index m = 0; m < nb; ++m) {
+            const double gap = evals(n) - evals(m);
+            if (m == n || std::abs(gap) < 1e-8) continue; // skip degenerate partners
+            const double w = 1.0 / (gap * gap);
+            for (int i = 0; i < dimension; ++i) {
+                const std::complex<double> a_i = velocities[i](n, m) * w;
+                for (int j = 0; j < dimension; ++j) Q(i, j) += a_i * std::conj(velocities[j](n, m));
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief Quantum geometric tensor of all bands at k from a single diagonalization
+ * @details ∂H/∂k_i comes from Hamiltonian::dHdk when the model provides it and from the
+ * 4th-order stencil of dHdk(H, k, ...) otherwise; only the first `dimension` directions are differentiated.
+ * @param H Hamiltonian object
+ * @param k Wavevector (k-point) in reciprocal space
+ * @param dimension Number of k-directions (2 for planar models, 3 for Ω_x and Ω_y as well)
+ * @param dk Finite-difference step for models without analytic ∂H
+ * @param ws Caller-owned workspace (one per thread); ws.e0 holds the eigensystem afterwards
+ * @param out Receives Q^n for every band
+ */
+inline void quantumGeometricTensor(const Hamiltonian& H, const Eigen::Vector3d& k, int dimension,
+                                   double dk, BerryWorkspace& ws, QuantumGeometricTensor& out) {
+    H.eigensystem(k, ws.e0);
+    const Eigen::MatrixXcd& U = ws.e0.evecs;
+
+    for (int i = 0; i < dimension; ++i) {
+        if (!H.dHdk(k, i, ws.dH)) dHdk(H, k, i, dk, ws, ws.dH);
+        ws.product.noalias() = ws.dH * U;
+        ws.velocities[i].noalias() = U.adjoint() * ws.product;
+    }
+    quantumGeometricTensor(ws.e0.evals, ws.velocities, dimension, out);
+}
+
+
+/**
+ * @brief Batched quantum geometric tensor over many k-points and all bands
+ * @param H Hamiltonian object
+ * @param kpoints List of k-points (e.g. mesh.getKPoints() or a slice of it)
+ * @param dimension Number of k-directions (e.g. mesh.dimension())
+ * @param dk Finite-difference step for models without analytic ∂H
+ * @param ws Caller-owned workspace (one per thread)
+ * @return Metric and curvature of every band, one row per k-point
+ */
+inline QuantumGeometryMap quantumGeometryBatch(const Hamiltonian& H,
+                                               const std::vector<Eigen::Vector3d>& kpoints,
+                                               int dimension, double dk, BerryWorkspace& ws) {
+    QuantumGeometryMap map;
+    QuantumGeometricTensor qgt;
+
+    for (size_t ik = 0; ik < kpoints.size(); ++ik) {
+        quantumGeometricTensor(H, kpoints[ik], dimension, dk, ws, qgt);
+        if (ik == 0) {
+            map.metric.resize(static_cast<Eigen::Index>(kpoints.size()), 6 * qgt.bands());
+            map.curvature.resize(static_cast<Eigen::Index>(kpoints.size()), 3 * qgt.bands());
+        }
+        map.store(static_cast<Eigen::Index>(ik), qgt);
+    }
+    return map;
 }
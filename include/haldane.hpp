@@ -1,11 +1,11 @@
 #pragma once
-#include "hamiltonian.hpp"
+#include "two_band.hpp"
 #include <complex>
 #include <cmath>
 
 /// @brief Haldane model for a two-dimensional topological insulator
 /// @file haldane.hpp
-class HaldaneModel : public Hamiltonian {
+class HaldaneModel : public TwoBandModel {
 public:
     double t1;     // NN hopping
     double t2;     // NNN hopping
@@ -22,22 +22,55 @@ public:
     HaldaneModel(double t1 = 1.0, double t2 = 0.1, double phi = M_PI / 2.0, double M = 0.2)
         : t1(t1), t2(t2), phi(phi), M(M) {}
 
-    /// @brief Return the Hamiltonian matrix H(k) at wavevector k
-    Mat Hk(const Vec& k) const override {
-        using namespace std::complex_literals;
-        using std::cos, std::sin;
+    /// @brief Hexagonal reciprocal lattice of this gauge: b1 = (2π, 2π/√3), b2 = (0, 4π/√3)
+    Eigen::Matrix3d reciprocalBasis() const override {
+        Eigen::Matrix3d b = Eigen::Matrix3d::Zero();
+        b.col(0) << 2.0 * M_PI, 2.0 * M_PI / std::sqrt(3.0), 0.0;
+        b.col(1) << 0.0, 4.0 * M_PI / std::sqrt(3.0), 0.0;
+        b.col(2) << 0.0, 0.0, 2.0 * M_PI;
+        return b;
+    }
+
+    /// @brief ε = 0, d = (Re f, Im f, d_z) with f = t1 (1 + e^{-i p1} + e^{-i p2}),
+    /// d_z = M - 2 t2 sin φ (sin p1 - sin p2) and p_i = a_i·k
+    void pauliVector(const Vec& k, double& eps, Eigen::Vector3d& d) const override {
         const std::complex<double> I(0,1);
+        const double p1 = a1().dot(k), p2 = a2().dot(k);
 
+        const std::complex<double> f = t1 * (1.0 + std::exp(-I * p1) + std::exp(-I * p2));
+        eps = 0.0;
+        d << f.real(), f.imag(), M - 2.0 * t2 * std::sin(phi) * (std::sin(p1) - std::sin(p2));
+    }
 
-        double kx = k(0), ky = k(1);
-        std::complex<double> f = t1 * (1.0 + std::exp(-I * kx) + std::exp(-I * (kx / 2 + std::sqrt(3) * ky / 2)));
-        double d_x = f.real();
-        double d_y = f.imag();
-        double d_z = M - 2.0 * t2 * sin(phi) * (sin(kx) - sin(kx / 2 + std::sqrt(3) * ky / 2));
+    /// @brief Analytic gradients of d (zero along kz)
+    void pauliGradient(const Vec& k, Eigen::Vector3d& grad_eps, Eigen::Matrix3d& grad_d) const override {
+        const std::complex<double> I(0,1);
+        const Eigen::Vector3d a1 = this->a1(), a2 = this->a2();
+        const double p1 = a1.dot(k), p2 = a2.dot(k);
 
-        Mat H(2, 2);
-        H << d_z, d_x - I * d_y,
-             d_x + I * d_y, -d_z;
-        return H;
+        grad_eps.setZero();
+        for (int i = 0; i < 3; ++i) {
+            const std::complex<double> df = -I * t1 * (a1(i) * std::exp(-I * p1) + a2(i) * std::exp(-I * p2));
+            grad_d.col(i) << df.real(), df.imag(),
+                -2.0 * t2 * std::sin(phi) * (a1(i) * std::cos(p1) - a2(i) * std::cos(p2));
+        }
     }
+
+    /// @brief Analytic second derivatives of d (zero if either direction is kz)
+    bool pauliHessian(const Vec& k, int i, int j, double& eps_ij, Eigen::Vector3d& d_ij) const override {
+        const std::complex<double> I(0,1);
+        const Eigen::Vector3d a1 = this->a1(), a2 = this->a2();
+        const double p1 = a1.dot(k), p2 = a2.dot(k);
+
+        const std::complex<double> d2f = -t1 * (a1(i) * a1(j) * std::exp(-I * p1) + a2(i) * a2(j) * std::exp(-I * p2));
+        eps_ij = 0.0;
+        d_ij << d2f.real(), d2f.imag(),
+            2.0 * t2 * std::sin(phi) * (a1(i) * a1(j) * std::sin(p1) - a2(i) * a2(j) * std::sin(p2));
+        return true;
+    }
+
+private:
+    /// @brief Bond vectors of the phases p_i = a_i·k
+    static Eigen::Vector3d a1() { return Eigen::Vector3d(1.0, 0.0, 0.0); }
+    static Eigen::Vector3d a2() { return Eigen::Vector3d(0.5, std::sqrt(3) / 2, 0.0); }
 };
@@ -1,5 +1,139 @@
 #pragma once
 #include <Eigen/Dense>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+/// EigenWorkspace reuses Eigen's tridiagonal eigensolver internals (tridiagonalization_inplace,
+/// computeFromTridiagonal_impl, m_maxIterations), which are not part of the public API and have
+/// only been checked against Eigen 3.3 and 3.4. Other versions fall back to the public
+/// SelfAdjointEigenSolver: same results, but solveWindow then diagonalizes the full spectrum.
+/// Define QT_EIGEN_TRIDIAGONAL_INTERNALS to 0 or 1 to override the version check.
+#ifndef QT_EIGEN_TRIDIAGONAL_INTERNALS
+#if EIGEN_VERSION_AT_LEAST(3, 3, 0) && !EIGEN_VERSION_AT_LEAST(3, 4, 90)
+#define QT_EIGEN_TRIDIAGONAL_INTERNALS 1
+#else
+#define QT_EIGEN_TRIDIAGONAL_INTERNALS 0
+#endif
+#endif
+
+/// @brief Preallocated storage for repeated diagonalizations of H(k)
+/// @details Holds H(k), the eigenpairs and every scratch buffer of the Hermitian
+/// eigensolver. Once it has seen a matrix of a given size, filling Hk in place and
+/// calling solve() performs no heap allocations. Use one workspace per thread.
+class EigenWorkspace {
+public:
+    Eigen::MatrixXcd Hk;     ///< H(k), filled in place by Hamiltonian::Hk(k, out)
+    Eigen::VectorXd evals;   ///< Eigenvalues in ascending order
+    Eigen::MatrixXcd evecs;  ///< Eigenvectors (one per column)
+
+    explicit EigenWorkspace(Eigen::Index n = 0) { resize(n); }
+
+    /// @brief Preallocate all buffers for an n x n Hamiltonian
+    void resize(Eigen::Index n);
+
+    /// @brief Diagonalize the Hermitian matrix currently stored in Hk
+    /// @details Same algorithm as Eigen::SelfAdjointEigenSolver (Householder tridiagonalization
+    /// followed by implicit symmetric QR), with the Householder reflectors applied into the
+    /// preallocated workspace instead of a temporary.
+    /// @return Eigen::Success, or Eigen::NoConvergence if the QR iteration failed
+    Eigen::ComputationInfo solve();
+
+    /// @brief Eigenvalues of Hk only (ascending, into evals); evecs is left untouched
+    /// @details Same tridiagonalization as solve(), but the implicit QR runs without rotating
+    /// any vectors and the Householder reflectors are never accumulated, which removes the
+    /// O(N³) part of solve(). 2 x 2 matrices use the closed form (a + d)/2 ∓ √(((a - d)/2)² + |b|²),
+    /// and so do 4 x 4 matrices made of two decoupled 2 x 2 blocks.
+    Eigen::ComputationInfo solveEigenvalues();
+
+    /// @brief Diagonalize Hk for the nbands eigenpairs closest to center only
+    /// @details Two algorithms, chosen by size:
+    /// - N >= iterativeWindowMinOrbitals and 48 nbands <= N: block shift-invert subspace
+    ///   iteration. One LU of H - σ (σ ≈ center, O(N³) but a fraction of a full
+    ///   diagonalization), then Rayleigh-Ritz on a block Krylov space of (H - σ)⁻¹ built from
+    ///   nbands + nbands / 2 guard vectors, until every window residual ||H x - θ x|| is below
+    ///   1e-12 ||H||∞. The block of the previous call is the start basis of the next, so
+    ///   neighbouring k-points converge in a few steps. Falls back to the direct algorithm if
+    ///   it has not converged after 50 steps.
+    /// - Otherwise (direct): same Householder tridiagonalization as solve(), all eigenvalues of
+    ///   the tridiagonal matrix without vectors (O(N²)), inverse iteration for the selected
+    ///   eigenvalues and back-transformation of those nbands vectors only.
+    /// On return evals has nbands entries (ascending) and evecs is N x nbands;
+    /// excludedBelow / excludedAbove bound the nearest eigenvalues outside the window.
+    /// @param nbands Number of bands in the window (the full spectrum if nbands >= N)
+    /// @param center Energy the window is centred on (e.g. the Fermi level)
+    Eigen::ComputationInfo solveWindow(Eigen::Index nbands, double center);
+
+    /// @brief Eigenvalues of the solveWindow window only (evecs is left untouched)
+    /// @details Same algorithm choice, evals, excludedBelow and excludedAbove as solveWindow;
+    /// the direct path stops after the tridiagonal eigenvalues.
+    Eigen::ComputationInfo solveWindowEigenvalues(Eigen::Index nbands, double center);
+
+    /// @brief Highest eigenvalue below the last window (-inf after solve() or if there is none)
+    /// @details Exact on the direct path. The iterative path reports the nearest guard Ritz
+    /// value moved towards the window by its residual, which can only overstate the truncation
+    /// bound of KuboSolver.
+    double excludedBelow = -std::numeric_limits<double>::infinity();
+    /// @brief Lowest eigenvalue above the last window (+inf after solve() or if there is none)
+    double excludedAbove = std::numeric_limits<double>::infinity();
+
+    /// @brief Orbital count from which solveWindow uses the iterative solver
+    /// @details Below it the LU and the Krylov solves cost about as much as the full
+    /// diagonalization they replace without AVX (see validate_fast_paths).
+    Eigen::Index iterativeWindowMinOrbitals = 768;
+    /// @brief Rayleigh-Ritz steps of the last solveWindow call (0 on the direct path)
+    int windowIterations = 0;
+
+private:
+#if QT_EIGEN_TRIDIAGONAL_INTERNALS
+    /// @brief Scale and tridiagonalize Hk into reflectors_; returns the scale factor
+    double tridiagonalize();
+
+    /// @brief All eigenvalues of the tridiagonalized Hk into all_evals_ (scaled by 1/scale)
+    Eigen::ComputationInfo tridiagonalEigenvalues();
+#else
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> fallback_;
+#endif
+
+    /// @brief Direct window: tridiagonal eigenvalues (and, if vectors, inverse iteration)
+    Eigen::ComputationInfo solveWindowDirect(Eigen::Index nbands, double center, bool vectors);
+
+    /// @brief Iterative window into window_vectors_ / evals; false if it did not converge
+    bool solveWindowIterative(Eigen::Index nbands, double center);
+
+    /// @brief Orthonormalize columns [first, last) of krylov_ against all columns before them
+    /// (classical Gram-Schmidt, applied twice), dropping dependent ones; returns the new end
+    Eigen::Index orthonormalizeKrylov(Eigen::Index first, Eigen::Index last);
+
+    /// @brief First index of the nbands contiguous entries of all_evals_ closest to target;
+    /// sets excludedBelow / excludedAbove to their neighbours (times scale)
+    Eigen::Index windowStart(Eigen::Index nbands, double target, double scale);
+
+    Eigen::MatrixXcd reflectors_;
+    Eigen::VectorXd subdiag_;
+    Eigen::VectorXcd hcoeffs_;
+    Eigen::VectorXcd householder_work_;
+
+    // Band-window scratch: tridiagonal copy, all eigenvalues, pivoted tridiagonal LU
+    Eigen::VectorXd tridiag_diag_, tridiag_sub_, all_evals_;
+    Eigen::VectorXd lu_dl_, lu_d_, lu_du_, lu_du2_, inverse_iterate_;
+    Eigen::VectorXi lu_pivot_;
+    Eigen::MatrixXd tridiag_vectors_;
+
+    // Iterative window: LU of H - σ, Krylov basis and its image under (H - σ)⁻¹, Ritz block
+    // (kept between calls as the next start basis), projected eigenproblem
+    Eigen::PartialPivLU<Eigen::MatrixXcd> shifted_lu_;
+    Eigen::MatrixXcd krylov_, krylov_image_, ritz_block_, ritz_image_, window_vectors_;
+    Eigen::MatrixXcd projected_, ritz_coefficients_;
+    Eigen::VectorXcd krylov_overlap_;
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> projected_solver_;
+    Eigen::VectorXd ritz_values_, ritz_residuals_;
+    std::vector<Eigen::Index> ritz_order_;
+    std::minstd_rand start_generator_; // fixed seed: reproducible start blocks
+};
+
 
 ///  @brief Hamiltonian.hpp
 ///  @file hamiltonian.hpp
@@ -14,7 +148,64 @@ public:
     /// @brief Return complex matrix H(k)
     virtual Mat Hk(const Vec& k) const = 0; // 
 
+    /// @brief Write H(k) into an existing matrix
+    /// @details Models override this to fill `out` element-wise, so that a correctly sized
+    /// `out` is reused without allocating. The default copies the result of Hk(k).
+    virtual void Hk(const Vec& k, Mat& out) const { out = Hk(k); }
+
     /// @brief Return the eigenvalues and eigenvectors of H(k)
     virtual void eigensystem(const Vec& k, Eigen::VectorXd& evals, Eigen::MatrixXcd& evecs) const; 
+
+    /// @brief Diagonalize H(k) into a reusable workspace (ws.evals, ws.evecs)
+    virtual void eigensystem(const Vec& k, EigenWorkspace& ws) const;
+
+    /// @brief Return the eigenvalues of H(k) only (ascending)
+    /// @details For energy-only consumers (DOS, band energies, finite-difference velocities):
+    /// skips the eigenvector accumulation of eigensystem, which dominates for multi-band models.
+    virtual void eigenvalues(const Vec& k, Eigen::VectorXd& evals) const;
+
+    /// @brief Eigenvalues of H(k) into ws.evals without allocating; ws.evecs is not updated
+    virtual void eigenvalues(const Vec& k, EigenWorkspace& ws) const;
+
+    /// @brief Reciprocal lattice vectors b1, b2, b3 (columns) under which H(k + b_i) = H(k)
+    /// @details Defaults to 2π along each Cartesian axis (square/cubic lattice with unit spacing).
+    virtual Eigen::Matrix3d reciprocalBasis() const {
+        return 2.0 * M_PI * Eigen::Matrix3d::Identity();
+    }
+
+    /// @brief Number of terms in the optional decomposition H(k) = Σ_p c_p H_p(k)
+    /// @details Models whose parameters enter linearly expose the parameter-free matrices
+    /// H_p(k) and their own coefficients c_p, so that a TermCache can evaluate the
+    /// k-dependence once and sweep the parameters by recombining. 0 means no decomposition.
+    virtual int numTerms() const { return 0; }
+
+    /// @brief Write the term matrices H_p(k), p = 0..numTerms()-1, into terms
+    virtual void termMatrices(const Vec& k, std::vector<Mat>& terms) const {
+        (void)k;
+        (void)terms;
+        throw std::runtime_error("Hamiltonian: model does not provide a term decomposition");
+    }
+
+    /// @brief Coefficients c_p of this instance in the term decomposition
+    virtual Eigen::VectorXd termCoefficients() const { return Eigen::VectorXd(); }
+
+    /// @brief Analytic ∂H/∂k_direction, for models that can provide it cheaply
+    /// @return false if the model has no analytic derivative; callers then difference Hk
+    virtual bool dHdk(const Vec& k, int direction, Mat& out) const {
+        (void)k;
+        (void)direction;
+        (void)out;
+        return false;
+    }
+
+    /// @brief Analytic ∂²H/∂k_i∂k_j, for models that can provide it cheaply
+    /// @return false if the model has no analytic second derivative; callers then difference dHdk or Hk
+    virtual bool d2Hdk2(const Vec& k, int i, int j, Mat& out) const {
+        (void)k;
+        (void)i;
+        (void)j;
+        (void)out;
+        return false;
+    }
     
-};
\ No newline at end of file
+};
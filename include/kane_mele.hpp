@@ -1,13 +1,14 @@
 #pragma once
 #include "hamiltonian.hpp"
 #include <complex>
+#include <cmath>
 #include <Eigen/Dense>
-#include <unsupported/Eigen/KroneckerProduct>
 
 
 /// @brief Kane-Mele model for a two-dimensional topological insulator
 class KaneMeleModel : public Hamiltonian {
 public:
+    using Hamiltonian::Hk;
 
     /// @param t Hopping parameter
     /// @param lambda_SO Spin-orbit coupling strength
@@ -33,51 +34,65 @@ public:
     /// @details The Hamiltonian is a 4x4 matrix that includes the effects of spin-orbit coupling and Rashba interaction.
     /// @param k Wavevector in reciprocal space
     /// @return Hamiltonian matrix H(k) as a 4x4 complex matrix
-    /// @note The Hamiltonian is constructed using Pauli matrices and includes a sublattice part similar to graphene.
+    /// @note Symmetry checks (time reversal, hermiticity, periodicity) live in model_validation.hpp.
     Mat Hk(const Vec& k) const override {
-        using namespace std::complex_literals; 
-        double kx = k(0), ky = k(1);
-        const std::complex<double> I(0, 1);
+        Mat H(4, 4);
+        Hk(k, H);
+        return H;
+    }
 
-        // Pauli matrices
-        Eigen::Matrix2cd sigma_x, sigma_y, sigma_z;
-        sigma_x << 0, 1,
-                   1, 0;
-        sigma_y << 0, -I,
-                   I, 0;
-        sigma_z << 1, 0,
-                   0, -1;
-                   
-        // Sublattice part (similar to graphene)
-        //double f_re =  std::cos(kx) + 2.0 * std::cos(kx / 2.0) * std::cos(std::sqrt(3) * ky / 2.0);
-        //double f_im = -std::sin(kx) - 2.0 * std::sin(kx / 2.0) * std::cos(std::sqrt(3) * ky / 2.0);
-        //std::complex<double> f = f_re + I * f_im;
-        std::complex<double> f = std::exp(I*kx) 
-                       + 2.0 * std::exp(I*kx/2.0) * std::cos(std::sqrt(3)*ky/2.0);
+    /// @brief Write the 4x4 H(k) into out; basis (A↑, B↑, A↓, B↓)
+    void Hk(const Vec& k, Mat& out) const override {
+        out = fixedHk(k);
+    }
+
+    /// @brief Unitary part U of the time-reversal operator Θ = U K, with U = i s_y ⊗ 1
+    /// @details For use with validateModel: Θ is a symmetry if U H(k)* U† = H(-k).
+    static Eigen::Matrix4cd timeReversalOperator() {
+        Eigen::Matrix4cd U = Eigen::Matrix4cd::Zero();
+        U.block<2,2>(0,2) = Eigen::Matrix2cd::Identity();
+        U.block<2,2>(2,0) = -Eigen::Matrix2cd::Identity();
+        return U;
+    }
+
+    /// @brief Hexagonal reciprocal lattice of this gauge: b1 = (2π, 2π/√3), b2 = (0, 4π/√3)
+    Eigen::Matrix3d reciprocalBasis() const override {
+        Eigen::Matrix3d b = Eigen::Matrix3d::Zero();
+        b.col(0) << 2.0 * M_PI, 2.0 * M_PI / std::sqrt(3.0), 0.0;
+        b.col(1) << 0.0, 4.0 * M_PI / std::sqrt(3.0), 0.0;
+        b.col(2) << 0.0, 0.0, 2.0 * M_PI;
+        return b;
+    }
 
-        // Build 2x2 H(k) ignoring spin
-        Eigen::Matrix2cd H0;
-        H0 = -t * f.real() * sigma_x - t * f.imag() * sigma_y + lambda_v * sigma_z;
+private:
+    /// @brief Fixed-size construction of H(k) from scalar entries
+    Eigen::Matrix4cd fixedHk(const Vec& k) const {
+        const double kx = k(0), ky = k(1);
+        const std::complex<double> I(0, 1);
 
+        // Sublattice part (similar to graphene): H0 = -t Re f σ_x - t Im f σ_y + λ_v σ_z
+        const std::complex<double> f = std::exp(I*kx)
+                       + 2.0 * std::exp(I*kx/2.0) * std::cos(std::sqrt(3)*ky/2.0);
+        const std::complex<double> offdiag = -t * std::conj(f); // <A|H0|B>
 
-        // Spin-orbit term: 2x2 σ_z ⊗ s_z => expands to 4x4
+        // Spin-orbit term λ_SO σ_z ⊗ s_z on the spin-diagonal blocks
         Eigen::Matrix4cd H = Eigen::Matrix4cd::Zero();
-        H.block<2,2>(0,0) = H0 + lambda_SO * sigma_z;  // spin up
-        H.block<2,2>(2,2) = H0 - lambda_SO * sigma_z;   // spin down
-
-        // Verify time-reversal symmetry: TH(k)T⁻¹ = H(-k)
-        Eigen::Matrix4cd T = Eigen::kroneckerProduct(sigma_x, Eigen::Matrix2cd::Identity());
-        T *= I;  // T = iσ_x ⊗ I
-        assert((T * Hk(k) * T.inverse() - Hk(-k)).norm() < 1e-10);
+        H(0,0) =  lambda_v + lambda_SO;   H(0,1) = offdiag;
+        H(1,0) = std::conj(offdiag);      H(1,1) = -lambda_v - lambda_SO;
+        H(2,2) =  lambda_v - lambda_SO;   H(2,3) = offdiag;
+        H(3,2) = std::conj(offdiag);      H(3,3) = -lambda_v + lambda_SO;
 
-        // Rashba coupling (if needed)
+        // Rashba coupling λ_R (sin kx σ_x - sin ky σ_y) between the spin blocks
         if (include_Rashba) {
-            H.block<2,2>(0,2) = lambda_R*(std::sin(kx)*sigma_x - std::sin(ky)*sigma_y);
-            H.block<2,2>(2,0) = H.block<2,2>(0,2).adjoint();
+            const double rx = lambda_R * std::sin(kx);
+            const double ry = lambda_R * std::sin(ky);
+            H(0,3) = std::complex<double>(rx, ry);
+            H(1,2) = std::complex<double>(rx, -ry);
+            H(3,0) = std::conj(H(0,3));
+            H(2,1) = std::conj(H(1,2));
         }
-        
 
         return H;
     }
 
-};
\ No newline at end of file
+};
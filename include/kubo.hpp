@@ -2,7 +2,27 @@
 #pragma once
 #include "hamiltonian.hpp"
 #include "mesh.hpp"
+#include "progress.hpp"
 #include <Eigen/Dense>
+#include <array>
+#include <vector>
+
+/// @brief Frequency-resolved optical conductivity σ_ij(ω)
+struct OpticalConductivity {
+    std::vector<double> omega;            ///< Photon energies ħω
+    std::vector<Eigen::Matrix3cd> sigma;  ///< σ_ij(ω): Re = absorptive, Im = reactive part
+};
+
+/// @brief Diagnostics of the last computeTransportTensors call
+struct KuboStats {
+    size_t kpoints = 0;            ///< k-points summed on this rank
+    int orbitals = 0;              ///< Dimension of H(k)
+    int bands = 0;                 ///< Bands per k-point entering the sum (< orbitals with a band window)
+    double truncationBound = 0.0;  ///< Upper bound on |Δσ_ij| from bands outside the window (0 for the full spectrum)
+    size_t pairsTotal = 0;         ///< Band pairs n < m summed over k-points
+    size_t pairsVisited = 0;       ///< Pairs with a non-negligible occupation difference
+    size_t pairsSkipped = 0;       ///< Pairs skipped because both bands are fully occupied or fully empty
+};
 
 /// @brief Kubo-Greenwood solver for calculating the conductivity tensor
 class KuboSolver {
@@ -17,6 +37,51 @@ public:
     /// @return Tuple of {sigma, alpha, kappa}
     std::tuple<Eigen::Matrix3d, Eigen::Matrix3d, Eigen::Matrix3d> computeTransportTensors(double Ef, double T);
 
+    /// @brief Compute the interband optical conductivity σ_ij(ω) on a whole frequency grid
+    /// @details All frequencies are accumulated in the same pass over k and band pairs,
+    /// so the eigensystem and velocity matrices are evaluated once per k-point.
+    /// The ω → 0 limit reproduces the σ returned by computeTransportTensors.
+    /// @param omegas Frequency grid ħω (same units as the Hamiltonian)
+    /// @param Ef Fermi energy
+    /// @param T Temperature
+    /// @return Frequencies and complex conductivity tensors
+    OpticalConductivity computeOpticalConductivity(const std::vector<double>& omegas, double Ef, double T);
+
+    /// @brief Hall-type conductivities for several current operators in one pass over the mesh
+    /// @details For each observable O (an N x N matrix in the orbital basis of H, e.g. the identity
+    /// for charge or s_z ⊗ 1 for spin) the current is J^O_i = ½{O, v_i} and
+    /// σ^O_ij = Σ_k Σ_{n≠m} (f_n - f_m) Im(J^O_i,nm v_j,mn) / ((E_n - E_m)² + η²),
+    /// with the same prefactor as computeTransportTensors (the identity reproduces its σ).
+    /// Every observable shares one eigensystem and one set of velocity matrices per k-point;
+    /// each O is projected to the eigenbasis once per k. Diagonal components are not evaluated.
+    /// With a band window (WindowedHamiltonian) O and v_i are projected onto the window
+    /// eigenvectors, so J^O_i = ½{P O P, P v_i P} with P the window projector: products through
+    /// bands outside the window are dropped, in addition to the truncated pair sum.
+    /// @param observables Operators O in the orbital basis (full size N, also with a band window)
+    /// @throws std::invalid_argument if an observable is not N x N
+    /// @param Ef Fermi energy
+    /// @param T Temperature
+    /// @return One response tensor σ^O per observable, in the same order
+    std::vector<Eigen::Matrix3d> computeResponseTensors(const std::vector<Eigen::MatrixXcd>& observables,
+                                                        double Ef, double T);
+
+    /// @brief Diagnostics of the last computeTransportTensors call
+    /// @details With a band window (see WindowedHamiltonian) truncationBound bounds the
+    /// neglected interband terms of σ_ij for every component: pairs with one band outside
+    /// the window via the out-of-window weight ||∂H u_n||² - Σ_window |v_nm|², pairs with
+    /// both outside via ||∂H||_F², with the occupation differences and energy gaps to the
+    /// nearest excluded eigenvalues.
+    const KuboStats& lastStats() const { return stats; }
+
+    /// @brief Occupations within tol of 1 (or 0) count as fully occupied (empty) for pair pruning
+    /// @details Default 1e-12; 0 visits every pair with f_n ≠ f_m.
+    void setOccupationTolerance(double tol) { occupation_tolerance = tol; }
+
+    /// @brief Report k-point progress to p during the following calls (nullptr disables)
+    /// @details The reporter is started with the rank-local k-point count, bumped once per
+    /// k-point and finished when the loop ends. It is not owned by the solver.
+    void setProgress(ProgressReporter* p) { progress = p; }
+
 
 private:
     const Hamiltonian& H;
@@ -25,10 +90,36 @@ private:
     bool temperature_in_kelvin;
     double energy_scale;
 
+    /// @brief Fill velocity_matrices[0..Dim) with <n|∂H/∂k_i|m> at k (requires evecs at k)
+    /// @details Uses Hamiltonian::dHdk when the model provides it, central differences otherwise.
+    template <int Dim>
+    void computeVelocityMatrices(const Eigen::Vector3d& k);
 
-    // Reusable buffers
-    mutable Eigen::VectorXd evals;
-    mutable Eigen::MatrixXcd evecs;
+    // Compile-time 2D/3D kernels; the public methods dispatch on mesh.dimension() once per call
+    template <int Dim>
+    std::tuple<Eigen::Matrix3d, Eigen::Matrix3d, Eigen::Matrix3d> computeTransportTensorsImpl(double Ef, double T);
+
+    template <int Dim>
+    std::vector<Eigen::Matrix3d> computeResponseTensorsImpl(const std::vector<Eigen::MatrixXcd>& observables,
+                                                            double Ef, double T);
+
+    template <int Dim>
+    OpticalConductivity computeOpticalConductivityImpl(const std::vector<double>& omegas, double Ef, double T);
+
+    // Reusable buffers (sized on the first k-point, no allocations afterwards)
+    mutable EigenWorkspace eig_ws;
     mutable std::array<Eigen::MatrixXcd, 3> velocity_matrices;
-    mutable Eigen::MatrixXcd dH_buffer;
+    mutable Eigen::MatrixXcd H_plus, H_minus;
+    mutable Eigen::MatrixXcd dH_buffer, product_buffer;
+    mutable Eigen::VectorXd occupations;
+    mutable Eigen::ArrayXXd pair_weight, pair_weight_1, pair_weight_2;
+    mutable Eigen::ArrayXXd pair_energy, pair_im;
+    KuboStats stats;
+    double occupation_tolerance = 1e-12;
+    ProgressReporter* progress = nullptr;
+
+    mutable std::vector<Eigen::MatrixXcd> projected_observables;
+    mutable Eigen::MatrixXd out_of_window_weight; // ||∂_i H u_n||² - Σ_window |v^i_mn|² per direction and band
+    mutable Eigen::Vector3d dH_norm2;             // ||∂_i H||_F²
+    mutable Eigen::MatrixXcd current_buffer;
 };
@@ -6,6 +6,7 @@
 #include <string>
 #include <chrono>
 #include <iomanip>
+#include "progress.hpp"
 
 /** \file logInfo.hpp
  * \brief Provides colored logging functions for console output.
@@ -45,58 +46,23 @@ namespace QuantumTransport {
 
 
 
-/// @brief class for displaying progress in console applications. 
-
-class ProgressBar {
-private:
-    size_t total;
-    size_t current;
-    double start_time;
-    bool parallel;
-    
+/// @brief Console progress bar for examples (see ProgressReporter in progress.hpp)
+/// @details update() only bumps a relaxed atomic counter; the bar is redrawn by the
+/// reporter thread at 5 Hz instead of on every update, so it is safe to call from
+/// every thread of a parallel loop. The parallel flag is ignored (every update is thread-safe).
+class ProgressBar : public ProgressReporter {
 public:
-    ProgressBar(size_t total, bool parallel = false) 
-        : total(total), current(0), parallel(parallel) {
-        start_time = std::chrono::duration<double>(
-            std::chrono::steady_clock::now().time_since_epoch()).count();
-    }
-    
-    void update(size_t n = 1) {
-        if (parallel) {
-            #pragma omp atomic
-            current += n;
-        } else {
-            current += n;
-        }
-        
-        print();
-    }
-    
-    void print() {
-        const int barWidth = 50;
-        float progress = static_cast<float>(current) / total;
-        double now = std::chrono::duration<double>(
-            std::chrono::steady_clock::now().time_since_epoch()).count();
-        double elapsed = now - start_time;
-        
-        std::cout << "[";
-        int pos = barWidth * progress;
-        for (int i = 0; i < barWidth; ++i) {
-            if (i < pos) std::cout << "=";
-            else if (i == pos) std::cout << ">";
-            else std::cout << " ";
-        }
-        std::cout << "] " << int(progress * 100.0) << "% "
-                  << "(" << current << "/" << total << ") "
-                  << std::fixed << std::setprecision(1) << elapsed << "s\r";
-        std::cout.flush();
-    }
-    
-    void finish() {
-        current = total;
-        print();
-        std::cout << std::endl;
+    ProgressBar(size_t total, bool parallel = false) {
+        (void)parallel;
+        start(total);
     }
+
+    void update(size_t n = 1) { add(n); }
+
+    /// @brief Does nothing: the reporter thread draws the bar, and a draw from the caller would
+    /// race with it. Call finish() to draw the final state.
+    [[deprecated("the bar is redrawn by the reporter thread; call finish() for the final state")]]
+    void print() {}
 };
 
 #endif // LOG_INFO_HPP
\ No newline at end of file
@@ -1,8 +1,17 @@
 #pragma once // Include guard to prevent multiple inclusions
+#include <array>
 #include <vector>
+#include <cmath>
 #include <Eigen/Dense>
 
 /// @brief Represents a k-point mesh for Brillouin zone sampling
+/// @details Three kinds of meshes share this class:
+/// - the Cartesian box [-kmax, kmax]^d (constructor), which includes both ends of every
+///   axis and therefore carries trapezoidal weights (end points 1/2 per axis), and
+/// - Monkhorst–Pack meshes of the reciprocal unit cell (monkhorstPack), which sample every
+///   periodic image exactly once with uniform weights, and
+/// - explicit point lists with caller-supplied weights (e.g. the points a refined grid adds).
+/// Solvers average over weights(), so all integrate correctly.
 class Mesh {
 public:
     using Vec = Eigen::Vector3d;
@@ -11,21 +20,71 @@ public:
 
     /// @brief Construct a mesh with given dimensions
     Mesh(size_t nx, size_t ny, size_t nz = 1, double kmax = 2 * M_PI) ;
-        
+
+    /// @brief Monkhorst–Pack mesh of the unit cell spanned by the columns of basis
+    /// @details k = Σ_i (m_i + shift_i) / n_i b_i with m_i = 0..n_i-1. shift = 0 contains Γ;
+    /// shift_i = 0.5 on an even axis gives the original Monkhorst–Pack offset.
+    /// @param basis Reciprocal lattice vectors b1, b2, b3 (columns), e.g. H.reciprocalBasis()
+    /// @param n1 Points along b1
+    /// @param n2 Points along b2
+    /// @param n3 Points along b3 (1 for 2D models)
+    /// @param shift Offset of the grid in units of the grid spacing along each b_i
+    static Mesh monkhorstPack(const Eigen::Matrix3d& basis, size_t n1, size_t n2, size_t n3 = 1,
+                              const Vec& shift = Vec::Zero());
+
+    /// @brief Mesh of explicit k-points
+    /// @param kpoints Points to sample
+    /// @param weights One weight per point (solvers return Σ w_k Q(k), so weights normally sum to 1)
+    /// @param dimension 2 or 3: number of k-directions the solvers differentiate along
+    /// (no default: on a 2D list the solvers drop k_z derivatives, which a 3D list must not)
+    /// @throws std::invalid_argument on a weight count mismatch, another dimension, or k_z ≠ 0 in 2D
+    Mesh(std::vector<Vec> kpoints, std::vector<double> weights, int dimension);
+
     /// @brief Return all k-points in the mesh
     const std::vector<Vec>& getKPoints() const; 
 
+    /// @brief Integration weight of every k-point (sums to 1)
+    const std::vector<double>& weights() const;
+
     /// @brief Return the number of k-points
     size_t size() const;
 
+    /// @brief Spatial dimension of the mesh (2 if nz == 1, otherwise 3)
+    int dimension() const;
+
+    /// @brief Whether the mesh was built by monkhorstPack (then basis(), shift() and gridSize() describe it)
+    bool isMonkhorstPack() const { return monkhorst_pack_; }
+
+    /// @brief Reciprocal basis of a Monkhorst–Pack mesh (zero otherwise)
+    const Eigen::Matrix3d& basis() const { return basis_; }
+
+    /// @brief Grid offset of a Monkhorst–Pack mesh, in units of the grid spacing
+    const Vec& shift() const { return shift_; }
+
+    /// @brief Points along each axis; k-points are ordered with the last axis fastest
+    std::array<size_t, 3> gridSize() const { return {nx_, ny_, nz_}; }
+
 
 private:
-    size_t nx_, ny_, nz_;
-    double kmax_;
+    Mesh() = default;
+
+    size_t nx_ = 0, ny_ = 0, nz_ = 0;
+    double kmax_ = 0.0;
+    int dimension_ = 2;
+    bool monkhorst_pack_ = false;
+    Eigen::Matrix3d basis_ = Eigen::Matrix3d::Zero();
+    Vec shift_ = Vec::Zero();
     std::vector<Vec> kpoints_;
+    std::vector<double> weights_;
     // Uniform grid: k = 2 * pi * (i, j, [,k]) / N
 
+    /// @brief Coordinate of grid index i on an axis with n points
+    double coordinate(size_t i, size_t n) const;
+
+    /// @brief Trapezoidal weight of grid index i on an axis with n points (1 for n = 1)
+    static double trapezoidWeight(size_t i, size_t n);
+
     /// @brief Generate the mesh grid
     void generateMesh(); // Generate the k-point mesh based on nx, ny, nz, and kmax
 
-};
\ No newline at end of file
+};
@@ -0,0 +1,46 @@
+#pragma once
+#include "hamiltonian.hpp"
+#include "mesh.hpp"
+#include <Eigen/Dense>
+#include <cstddef>
+#include <iosfwd>
+
+/// @file model_validation.hpp
+/// @brief Opt-in symmetry and consistency checks for Hamiltonian models
+/// @details These checks used to live inside individual Hk implementations; they are
+/// meant to be run once per model (e.g. in tests or at start-up), never in the k-loop.
+
+/// @brief Settings for validateModel
+struct ValidationOptions {
+    double tolerance = 1e-10;        ///< Maximum allowed relative deviation
+    size_t samples = 256;            ///< Number of mesh points to check (evenly strided; 0 = all)
+    bool checkPeriodicity = true;    ///< Check H(k + b_i) = H(k) for H.reciprocalBasis()
+    bool checkTimeReversal = false;  ///< Check U H(k)* U† = H(-k)
+    Eigen::MatrixXcd timeReversalU;  ///< Unitary part U of the antiunitary Θ = U K
+};
+
+/// @brief Result of validateModel (errors are max ||ΔH|| / max(1, ||H||) over the sample)
+struct ValidationReport {
+    size_t pointsChecked = 0;
+    double hermiticityError = 0.0;
+    double periodicityError = 0.0;
+    double timeReversalError = 0.0;
+    bool hermitian = true;
+    bool periodic = true;
+    bool timeReversalSymmetric = true;
+
+    /// @brief True if every requested check passed
+    bool passed() const { return hermitian && periodic && timeReversalSymmetric; }
+};
+
+/// @brief Check hermiticity, periodicity and (optionally) time reversal of H on a sample of the mesh
+/// @details The sample points are processed in parallel with OpenMP.
+/// @param H Model to validate
+/// @param mesh Mesh whose k-points are sampled
+/// @param options Tolerance, sample size and which symmetries to check
+/// @return ValidationReport with the largest deviation found for each property
+ValidationReport validateModel(const Hamiltonian& H, const Mesh& mesh,
+                               const ValidationOptions& options = ValidationOptions());
+
+/// @brief Print a one-line-per-check summary of a report
+std::ostream& operator<<(std::ostream& os, const ValidationReport& report);
@@ -0,0 +1,246 @@
+#pragma once
+#include "hamiltonian.hpp"
+#include "mesh.hpp"
+#include "boltzmann.hpp"
+#include "geometry.hpp"
+#include "progress.hpp"
+#include <Eigen/Dense>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+/// @file pipeline.hpp
+/// @brief Streaming band pipeline: diagonalize every k-point once and feed several observables
+/// @details Producer threads diagonalize chunks of the mesh and build the velocity matrices
+/// <n|∂_i H|m>. Each registered stage consumes every chunk in its own thread, and a chunk is
+/// freed as soon as all stages are done with it. The queues between producers and stages are
+/// bounded, so at most producers + stages × (queueDepth + 1) chunks are alive at any time,
+/// independent of the mesh size. A full DOS + Kubo + Boltzmann + Berry analysis thus costs
+/// one diagonalization pass instead of one per solver.
+
+/// @brief Fixed-capacity FIFO between pipeline threads
+/// @details push blocks while the queue is full and pop while it is empty. After close(),
+/// push fails and pop drains the remaining items before failing.
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : capacity_(std::max<size_t>(capacity, 1)) {}
+
+    /// @return false if the queue was closed
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [&] { return closed_ || items_.size() < capacity_; });
+        if (closed_) return false;
+        items_.push_back(std::move(item));
+        not_empty_.notify_one();
+        return true;
+    }
+
+    /// @return false once the queue is closed and empty
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [&] { return closed_ || !items_.empty(); });
+        if (items_.empty()) return false;
+        item = std::move(items_.front());
+        items_.pop_front();
+        not_full_.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        not_full_.notify_all();
+        not_empty_.notify_all();
+    }
+
+private:
+    size_t capacity_;
+    std::deque<T> items_;
+    bool closed_ = false;
+    std::mutex mutex_;
+    std::condition_variable not_full_, not_empty_;
+};
+
+
+/// @brief Eigen-data of a contiguous block of mesh k-points
+struct BandChunk {
+    size_t begin = 0;                      ///< Mesh index of the first k-point
+    int dimension = 2;                     ///< Velocity directions filled (mesh dimension)
+    std::vector<Eigen::VectorXd> evals;    ///< Eigenvalues per k-point (ascending)
+    std::vector<std::array<Eigen::MatrixXcd, 3>> velocities; ///< <n|∂_i H|m>, i < dimension (empty if no stage needs them)
+
+    size_t size() const { return evals.size(); }
+};
+
+
+/// @brief Consumer of the chunks of one BandPipeline::run
+/// @details Each stage runs in its own thread; its methods are never called concurrently.
+/// Chunks arrive in no particular order.
+class PipelineStage {
+public:
+    virtual ~PipelineStage() = default;
+
+    /// @brief Whether chunks must carry velocity matrices
+    /// @details If no stage does, producers compute eigenvalues only (Hamiltonian::eigenvalues).
+    virtual bool needsVelocities() const { return true; }
+
+    /// @brief Reset the accumulators before the first chunk
+    /// @param nBands Eigenvalues per k-point, the same on every rank (even one without k-points)
+    virtual void begin(const Mesh& mesh, Eigen::Index nBands) = 0;
+
+    /// @brief Process one chunk
+    virtual void consume(const BandChunk& chunk) = 0;
+
+    /// @brief Called on the calling thread after the last chunk (MPI reductions go here)
+    virtual void finish() {}
+};
+
+
+/// @brief Settings for BandPipeline
+struct PipelineOptions {
+    size_t chunkSize = 256;   ///< k-points per chunk
+    size_t queueDepth = 4;    ///< Chunks buffered per stage
+    int producers = 0;        ///< Diagonalization threads (0: hardware threads, at least 1)
+    double dk = 1e-5;         ///< Step of the finite-difference ∂H for models without Hamiltonian::dHdk
+};
+
+
+/// @brief Producer/consumer pipeline over the (rank-local) k-points of a mesh
+class BandPipeline {
+public:
+    /// @param H Model (must outlive the pipeline; eigensystem and dHdk are called from several threads)
+    /// @param mesh k-point mesh (must outlive the pipeline)
+    BandPipeline(const Hamiltonian& H, const Mesh& mesh, const PipelineOptions& options = PipelineOptions());
+
+    /// @brief Register a stage (not owned; must outlive run())
+    void addStage(PipelineStage& stage) { stages.push_back(&stage); }
+
+    /// @brief Stream the mesh through all stages
+    /// @details Exceptions thrown by the model or a stage stop the pipeline and are rethrown here.
+    void run();
+
+    /// @brief Report k-point progress to p during run() (nullptr disables)
+    void setProgress(ProgressReporter* p) { progress = p; }
+
+    /// @brief Largest number of chunks alive at once during the last run()
+    size_t peakChunks() const { return peak_chunks; }
+
+private:
+    const Hamiltonian& H;
+    const Mesh& mesh;
+    PipelineOptions options;
+    std::vector<PipelineStage*> stages;
+    ProgressReporter* progress = nullptr;
+    size_t peak_chunks = 0;
+};
+
+
+/// @brief Gaussian-smeared DOS, as DOS::computeDOS
+class DOSStage : public PipelineStage {
+public:
+    DOSStage(double Emin, double Emax, int nBins, double sigma);
+
+    bool needsVelocities() const override { return false; }
+    void begin(const Mesh& mesh, Eigen::Index nBands) override;
+    void consume(const BandChunk& chunk) override;
+    void finish() override;
+
+    const std::vector<double>& dos() const { return dos_; }
+    const std::vector<double>& energies() const { return energies_; }
+
+private:
+    double Emin, Emax, sigma;
+    int nBins;
+    const Mesh* mesh = nullptr;
+    std::vector<double> dos_, energies_;
+};
+
+
+/// @brief Kubo σ, α and κ, as KuboSolver::computeTransportTensors (without pair pruning and window bound)
+class KuboStage : public PipelineStage {
+public:
+    KuboStage(double Ef, double T, double eta = 1e-3,
+              bool temperature_in_kelvin = false, double energy_scale = 1.0);
+
+    void begin(const Mesh& mesh, Eigen::Index nBands) override;
+    void consume(const BandChunk& chunk) override;
+    void finish() override;
+
+    const Eigen::Matrix3d& sigma() const { return sigma_; }
+    const Eigen::Matrix3d& alpha() const { return alpha_; }
+    const Eigen::Matrix3d& kappa() const { return kappa_; }
+
+private:
+    double Ef, T, eta;
+    bool temperature_in_kelvin;
+    double energy_scale;
+    const Mesh* mesh = nullptr;
+    Eigen::Matrix3d L0, L1, L2;
+    Eigen::Matrix3d sigma_, alpha_, kappa_;
+    Eigen::VectorXd occupations;
+};
+
+
+/// @brief Boltzmann σ and α, as BoltzmannSolver::computeTransportTensors on a model with analytic ∂H
+/// @details Band velocities and Ω come from the chunk's velocity matrices; the field terms
+/// and the per-state kernel are the solver's (BoltzmannSolver::fieldVelocity, accumulateState).
+class BoltzmannStage : public PipelineStage {
+public:
+    /// @param solver Supplies τ and the temperature convention (must outlive the stage)
+    BoltzmannStage(const BoltzmannSolver& solver, double Ef, double T,
+                   const Eigen::Vector3d& gradT, const Eigen::Vector3d& Efield,
+                   const Eigen::Vector3d& Bfield);
+
+    void begin(const Mesh& mesh, Eigen::Index nBands) override;
+    void consume(const BandChunk& chunk) override;
+    void finish() override;
+
+    const Eigen::Matrix3d& sigma() const { return sigma_; }
+    const Eigen::Matrix3d& alpha() const { return alpha_; }
+
+private:
+    const BoltzmannSolver& solver;
+    double Ef, T;
+    Eigen::Vector3d gradT, Efield, Bfield;
+    const Mesh* mesh = nullptr;
+    Eigen::Matrix3d sigma_, alpha_;
+};
+
+
+/// @brief Berry curvature Ω_z of every band on the mesh (sum over states, berryCurvatureFHS sign)
+class BerryCurvatureStage : public PipelineStage {
+public:
+    void begin(const Mesh& mesh, Eigen::Index nBands) override;
+    void consume(const BandChunk& chunk) override;
+    void finish() override;
+
+    /// @brief Ω_z, one row per k-point and one column per band
+    const Eigen::MatrixXd& curvature() const { return curvature_; }
+
+private:
+    Eigen::MatrixXd curvature_;
+};
+
+
+/// @brief Quantum metric and Berry curvature vector of every band on the mesh (see quantumGeometricTensor)
+/// @details Directions beyond the mesh dimension have no velocity matrices, so on 2D meshes
+/// only g_xx, g_yy, g_xy and Ω_z are nonzero.
+class QuantumGeometryStage : public PipelineStage {
+public:
+    void begin(const Mesh& mesh, Eigen::Index nBands) override;
+    void consume(const BandChunk& chunk) override;
+    void finish() override;
+
+    /// @brief Metric and curvature, one row per k-point (layout of QuantumGeometryMap)
+    const QuantumGeometryMap& geometry() const { return geometry_; }
+
+private:
+    QuantumGeometryMap geometry_;
+    QuantumGeometricTensor qgt;
+};
@@ -0,0 +1,67 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/// @file progress.hpp
+/// @brief Rate-limited progress reporting for (parallel) k-point loops
+/// @details Workers only increment a relaxed atomic counter; a single reporter thread
+/// redraws the bar at a fixed rate with throughput and ETA. The per-item cost is one
+/// uncontended fetch_add, so the reporter can stay enabled inside the solvers.
+
+class ProgressReporter {
+public:
+    /// @param label Text printed in front of the bar
+    /// @param rate_hz Redraws per second
+    /// @param out Stream the bar is drawn to
+    explicit ProgressReporter(std::string label = "", double rate_hz = 5.0);
+    ProgressReporter(std::string label, double rate_hz, std::ostream& out);
+
+    /// @brief Stops the reporter thread if it is still running
+    ~ProgressReporter();
+
+    ProgressReporter(const ProgressReporter&) = delete;
+    ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+    /// @brief Reset the counter to 0 of total and start the reporter thread
+    void start(size_t total);
+
+    /// @brief Record n finished items (thread-safe, lock-free)
+    void add(size_t n = 1) noexcept { count_.fetch_add(n, std::memory_order_relaxed); }
+
+    /// @brief Stop the reporter thread and draw the final state followed by a newline
+    void finish();
+
+    /// @brief Items recorded so far
+    size_t count() const noexcept { return count_.load(std::memory_order_relaxed); }
+
+    /// @brief Total set by the last start()
+    size_t total() const noexcept { return total_; }
+
+private:
+    /// @brief Reporter thread body: redraw every period until finish()
+    void run();
+
+    /// @brief Draw the current state once
+    /// @details Only called by the reporter thread (holding mutex_) and by finish() after
+    /// the thread has joined, so two draws never interleave on the stream.
+    void draw();
+
+    std::string label_;
+    double period_;
+    std::ostream& out_;
+
+    std::atomic<size_t> count_{0};
+    size_t total_ = 0;
+    std::chrono::steady_clock::time_point start_time_;
+
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+};
@@ -0,0 +1,106 @@
+#pragma once
+#include "hamiltonian.hpp"
+#include "mesh.hpp"
+#include <Eigen/Dense>
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/// @file term_cache.hpp
+/// @brief Mesh-resident term matrices for fast sweeps over linear model parameters
+/// @details For a model with H(k) = Σ_p c_p H_p(k) (see Hamiltonian::numTerms), the
+/// cache evaluates every H_p(k) and ∂H_p/∂k_i once per mesh point. A CachedHamiltonian
+/// then rebuilds H(k) and ∂H/∂k for any coefficient vector as a linear combination,
+/// without calling the model (and its cos/sin) again.
+/// This pays off when assembling H(k) and its derivatives dominates a solve: many hopping
+/// vectors per term, or no analytic ∂H (the cache stores the differences once). A CachedHamiltonian
+/// is a generic Hamiltonian, so a TwoBandModel loses its closed forms through it; sweep such
+/// cheap analytic models by rebuilding them instead.
+
+/// @brief Term matrices and their k-derivatives on all points of a mesh
+/// @details Memory: N² complex numbers per term, mesh point and stored derivative
+/// (1 + mesh.dimension() matrices per term). The cache is read-only after construction
+/// and can be shared between threads.
+class TermCache {
+public:
+    /// @param model Model with a term decomposition (must outlive the cache)
+    /// @param mesh Mesh whose points are cached
+    /// @param dk Central-difference step for ∂H_p/∂k_i (the step KuboSolver uses)
+    TermCache(const Hamiltonian& model, const Mesh& mesh, double dk = 1e-5);
+
+    const Hamiltonian& model() const { return model_; }
+    int numTerms() const { return nterms_; }
+    Eigen::Index orbitals() const { return n_; }
+    int dimension() const { return dim_; }
+    size_t size() const { return nk_; }
+
+    /// @brief Index of k in the cached mesh, or -1 if k is not a mesh point
+    /// @details Points match bit for bit, which is the case for k taken from the mesh.
+    std::ptrdiff_t find(const Eigen::Vector3d& k) const;
+
+    /// @brief out = Σ_p c_p H_p(k_ik)
+    void assemble(size_t ik, const Eigen::VectorXd& coefficients, Eigen::MatrixXcd& out) const;
+
+    /// @brief out = Σ_p c_p ∂H_p/∂k_direction at k_ik (direction < dimension())
+    void assembleDerivative(size_t ik, int direction, const Eigen::VectorXd& coefficients,
+                            Eigen::MatrixXcd& out) const;
+
+    /// @brief Bytes held by the cached matrices
+    size_t memoryBytes() const { return static_cast<size_t>(data_.size()) * sizeof(std::complex<double>); }
+
+private:
+    struct KeyHash {
+        size_t operator()(const std::array<std::uint64_t, 3>& key) const noexcept;
+    };
+
+    /// @brief Combine the nterms_ columns starting at column first into an n x n matrix
+    void combine(Eigen::Index first, const Eigen::VectorXd& coefficients, Eigen::MatrixXcd& out) const;
+
+    static std::array<std::uint64_t, 3> key(const Eigen::Vector3d& k);
+
+    const Hamiltonian& model_;
+    int nterms_;
+    int dim_;
+    Eigen::Index n_;
+    size_t nk_;
+
+    /// Flattened matrices, column ((ik * (1 + dim) + slot) * nterms + p); slot 0 is H_p, slot 1 + i is ∂_i H_p
+    Eigen::MatrixXcd data_;
+    std::unordered_map<std::array<std::uint64_t, 3>, size_t, KeyHash> index_;
+};
+
+
+/// @brief Hamiltonian Σ_p c_p H_p(k) assembled from a TermCache
+/// @details Hk and dHdk at mesh points only combine cached matrices; other k-points
+/// (e.g. finite-difference stencils) fall back to the model's term matrices with the
+/// same coefficients, so results never depend on whether a point was cached.
+/// Change the parameters with setCoefficients instead of rebuilding the model.
+/// Off-mesh evaluations use an internal scratch buffer: use one instance per thread.
+class CachedHamiltonian : public Hamiltonian {
+public:
+    /// @param cache Term cache (must outlive this object)
+    /// @param coefficients One coefficient per term (e.g. (t, J, λ) for AltermagnetModel)
+    CachedHamiltonian(const TermCache& cache, const Eigen::VectorXd& coefficients);
+
+    /// @brief Move to another parameter point
+    void setCoefficients(const Eigen::VectorXd& coefficients);
+    const Eigen::VectorXd& coefficients() const { return coeffs; }
+
+    Mat Hk(const Vec& k) const override;
+    void Hk(const Vec& k, Mat& out) const override;
+
+    /// @brief Cached ∂H/∂k_direction at mesh points (false elsewhere)
+    bool dHdk(const Vec& k, int direction, Mat& out) const override;
+
+    Eigen::Matrix3d reciprocalBasis() const override { return cache.model().reciprocalBasis(); }
+
+    int numTerms() const override { return cache.numTerms(); }
+    void termMatrices(const Vec& k, std::vector<Mat>& terms) const override { cache.model().termMatrices(k, terms); }
+    Eigen::VectorXd termCoefficients() const override { return coeffs; }
+
+private:
+    const TermCache& cache;
+    Eigen::VectorXd coeffs;
+    mutable std::vector<Mat> scratch_terms;
+};
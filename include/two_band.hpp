@@ -0,0 +1,83 @@
+#pragma once
+#include "hamiltonian.hpp"
+#include <Eigen/Dense>
+
+/// @file two_band.hpp
+/// @brief Base class for two-band models H(k) = ε(k) σ₀ + d(k)·σ with closed-form bands
+
+/// @brief Band energies, velocities and Berry curvature of a two-band model at one k-point
+struct TwoBandGeometry {
+    Eigen::Vector2d energies;               ///< ε ∓ |d| (ascending, as the eigensolver)
+    Eigen::Matrix<double, 3, 2> velocities; ///< ∇ε ∓ d̂·∂_i d, one column per band
+    Eigen::Vector2d omega;                  ///< Ω_z per band, berryCurvatureFHS sign
+};
+
+
+/// @brief Two-band model H(k) = ε(k) σ₀ + d(k)·σ
+/// @details Derived models only supply ε, d and their gradients (and optionally their second
+/// derivatives). H(k), the eigensystem, ∂H/∂k and ∂²H/∂k² are then built in closed form:
+/// E_∓ = ε ∓ |d|, v_∓ = ∇ε ∓ d̂·∂d and Ω_∓ = ∓½ d̂·(∂_x d̂ × ∂_y d̂), with no eigensolver,
+/// finite differences or plaquettes. Solvers that need band velocities or Ω detect these
+/// models with dynamic_cast and call bandGeometry instead of their generic paths.
+class TwoBandModel : public Hamiltonian {
+public:
+    /// @brief Scalar part ε(k) and Pauli vector d(k)
+    virtual void pauliVector(const Vec& k, double& eps, Eigen::Vector3d& d) const = 0;
+
+    /// @brief ∇ε and the Jacobian of d, grad_d(a, i) = ∂d_a/∂k_i
+    virtual void pauliGradient(const Vec& k, Eigen::Vector3d& grad_eps, Eigen::Matrix3d& grad_d) const = 0;
+
+    /// @brief ∂_i∂_j ε and ∂_i∂_j d, for models that provide them
+    /// @return false if not available; d2Hdk2 then reports no analytic second derivative
+    virtual bool pauliHessian(const Vec& k, int i, int j, double& eps_ij, Eigen::Vector3d& d_ij) const {
+        (void)k;
+        (void)i;
+        (void)j;
+        (void)eps_ij;
+        (void)d_ij;
+        return false;
+    }
+
+    /// @brief H(k) = ε σ₀ + d·σ
+    Mat Hk(const Vec& k) const override {
+        Mat H(2, 2);
+        Hk(k, H);
+        return H;
+    }
+
+    /// @brief Write H(k) element-wise into out (no temporaries)
+    void Hk(const Vec& k, Mat& out) const override;
+
+    /// @brief Closed-form eigenpairs (ascending), see eigensystem(k, ws)
+    void eigensystem(const Vec& k, Eigen::VectorXd& evals, Eigen::MatrixXcd& evecs) const override;
+
+    /// @brief Closed-form eigenpairs into the workspace (ws.Hk is filled as well)
+    /// @details The eigenvectors use the gauge (|d| + d_z, d_x + i d_y) for d_z ≥ 0 and
+    /// (d_x - i d_y, |d| - d_z) otherwise, so no component vanishes away from d = 0.
+    /// At d = 0 the bands are degenerate and the eigenvectors are the standard basis.
+    void eigensystem(const Vec& k, EigenWorkspace& ws) const override;
+
+    /// @brief Closed-form eigenvalues ε ∓ |d| (ascending)
+    void eigenvalues(const Vec& k, Eigen::VectorXd& evals) const override;
+
+    /// @brief Closed-form eigenvalues into ws.evals (ws.Hk and ws.evecs are not touched)
+    void eigenvalues(const Vec& k, EigenWorkspace& ws) const override;
+
+    /// @brief ∂H/∂k_i = ∂_i ε σ₀ + ∂_i d·σ
+    bool dHdk(const Vec& k, int direction, Mat& out) const override;
+
+    /// @brief ∂²H/∂k_i∂k_j from pauliHessian (false if the model does not provide it)
+    bool d2Hdk2(const Vec& k, int i, int j, Mat& out) const override;
+
+    /// @brief Energies, band velocities and Ω_z of both bands from ε, d and their gradients
+    /// @details Ω_z = ∓½ d·(∂_x d × ∂_y d) / |d|³ for the lower / upper band in the sign
+    /// convention of berryCurvatureFHS (-(∂_x A_y - ∂_y A_x) with A = i<u|∇u>). Closer to the
+    /// band touching than |d| < 5e-9, the curvature is set to 0 like the degenerate pairs
+    /// skipped by the sum-over-states formulas. At d = 0 the velocities are those of the
+    /// standard-basis eigenvectors of eigensystem, ∇ε ± ∂d_z, as Hellmann-Feynman gives there.
+    void bandGeometry(const Vec& k, TwoBandGeometry& out) const;
+
+protected:
+    /// @brief out = e σ₀ + d·σ
+    static void writePauli(double e, const Eigen::Vector3d& d, Mat& out);
+};
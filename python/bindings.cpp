@@ -0,0 +1,308 @@
+/**
+ * \file bindings.cpp
+ * \brief Python module `quantumtransport`: models, Mesh, DOS, Kubo/Boltzmann solvers and Berry curvature.
+ *
+ * Results are returned as NumPy arrays that own the C++ result buffer through a capsule
+ * (no copy), or that are read-only views of a buffer of a live C++ object (e.g. Mesh.kpoints).
+ * Solver calls release the GIL, so several solvers can run from Python threads at once
+ * (one solver object per thread: solvers keep per-instance scratch buffers).
+ */
+#include <pybind11/pybind11.h>
+#include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include "altermagnet.hpp"
+#include "boltzmann.hpp"
+#include "dos.hpp"
+#include "geometry.hpp"
+#include "haldane.hpp"
+#include "hamiltonian.hpp"
+#include "kane_mele.hpp"
+#include "kubo.hpp"
+#include "mesh.hpp"
+#include "two_band.hpp"
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace py = pybind11;
+
+
+/// @brief Move a column-major Eigen object to the heap and expose it as an array owned by a capsule
+template <typename EigenType>
+py::array ownedArray(EigenType&& value) {
+    using Plain = std::decay_t<EigenType>;
+    using Scalar = typename Plain::Scalar;
+    static_assert(!Plain::IsRowMajor, "ownedArray expects column-major storage");
+
+    auto* owned = new Plain(std::move(value));
+    py::capsule owner(owned, [](void* p) { delete static_cast<Plain*>(p); });
+
+    const py::ssize_t rows = owned->rows(), cols = owned->cols();
+    if (Plain::ColsAtCompileTime == 1) {
+        return py::array_t<Scalar>({rows}, {py::ssize_t(sizeof(Scalar))}, owned->data(), owner);
+    }
+    return py::array_t<Scalar>({rows, cols},
+                               {py::ssize_t(sizeof(Scalar)), py::ssize_t(sizeof(Scalar)) * rows},
+                               owned->data(), owner);
+}
+
+/// @brief Move a std::vector<double> to the heap and expose it as a 1D array owned by a capsule
+inline py::array ownedArray(std::vector<double>&& value) {
+    auto* owned = new std::vector<double>(std::move(value));
+    py::capsule owner(owned, [](void* p) { delete static_cast<std::vector<double>*>(p); });
+    return py::array_t<double>({py::ssize_t(owned->size())}, {py::ssize_t(sizeof(double))},
+                               owned->data(), owner);
+}
+
+/// @brief Stack a list of 3x3 tensors into one (n, 3, 3) array without a per-tensor Python object
+template <typename Scalar>
+py::array stackedTensors(std::vector<Eigen::Matrix<Scalar, 3, 3>>&& tensors) {
+    using Tensors = std::vector<Eigen::Matrix<Scalar, 3, 3>>;
+    auto* owned = new Tensors(std::move(tensors));
+    py::capsule owner(owned, [](void* p) { delete static_cast<Tensors*>(p); });
+    const py::ssize_t s = sizeof(Scalar);
+    // Eigen 3x3 is column-major: element (i, j) of tensor n lives at n*9 + j*3 + i
+    return py::array_t<Scalar>({py::ssize_t(owned->size()), py::ssize_t(3), py::ssize_t(3)},
+                               {9 * s, s, 3 * s},
+                               owned->empty() ? nullptr : owned->front().data(), owner);
+}
+
+
+PYBIND11_MODULE(quantumtransport, m) {
+    m.doc() = "QuantumTransport++: tight-binding transport, Berry curvature and DOS";
+
+    // ------------------------------------------------------------------ models
+    py::class_<Hamiltonian>(m, "Hamiltonian")
+        .def("Hk", [](const Hamiltonian& H, const Eigen::Vector3d& k) {
+                return ownedArray(H.Hk(k));
+            }, py::arg("k"), "H(k) as a complex matrix")
+        .def("eigensystem", [](const Hamiltonian& H, const Eigen::Vector3d& k) {
+                EigenWorkspace ws;
+                H.eigensystem(k, ws);
+                return py::make_tuple(ownedArray(std::move(ws.evals)), ownedArray(std::move(ws.evecs)));
+            }, py::arg("k"), "(eigenvalues, eigenvectors) at k")
+        .def("eigenvalues", [](const Hamiltonian& H, const Eigen::Vector3d& k) {
+                EigenWorkspace ws;
+                H.eigenvalues(k, ws);
+                return ownedArray(std::move(ws.evals));
+            }, py::arg("k"), "Eigenvalues at k (no eigenvectors)")
+        .def("reciprocal_basis", [](const Hamiltonian& H) {
+                return ownedArray(Eigen::MatrixXd(H.reciprocalBasis()));
+            }, "Reciprocal lattice vectors as columns")
+        .def("bands", [](const Hamiltonian& H, const Mesh& mesh) {
+                // (number of k-points) x (number of bands), filled without the GIL
+                Eigen::MatrixXd bands;
+                {
+                    py::gil_scoped_release release;
+                    const auto& kpoints = mesh.getKPoints();
+                    EigenWorkspace ws;
+                    for (size_t ik = 0; ik < kpoints.size(); ++ik) {
+                        H.eigenvalues(kpoints[ik], ws);
+                        if (ik == 0) bands.resize(Eigen::Index(kpoints.size()), ws.evals.size());
+                        bands.row(Eigen::Index(ik)) = ws.evals.transpose();
+                    }
+                }
+                return ownedArray(std::move(bands));
+            }, py::arg("mesh"), "Eigenvalues on every mesh point, shape (nk, nbands)");
+
+    py::class_<TwoBandModel, Hamiltonian>(m, "TwoBandModel")
+        .def("band_geometry", [](const TwoBandModel& H, const Eigen::Vector3d& k) {
+                TwoBandGeometry geometry;
+                H.bandGeometry(k, geometry);
+                return py::make_tuple(ownedArray(Eigen::VectorXd(geometry.energies)),
+                                      ownedArray(Eigen::MatrixXd(geometry.velocities)),
+                                      ownedArray(Eigen::VectorXd(geometry.omega)));
+            }, py::arg("k"), "Closed-form (energies, velocities (3 x 2), Omega_z) of both bands at k");
+
+    py::class_<HaldaneModel, TwoBandModel>(m, "HaldaneModel")
+        .def(py::init<double, double, double, double>(),
+             py::arg("t1") = 1.0, py::arg("t2") = 0.1, py::arg("phi") = M_PI / 2.0, py::arg("M") = 0.2)
+        .def_readwrite("t1", &HaldaneModel::t1)
+        .def_readwrite("t2", &HaldaneModel::t2)
+        .def_readwrite("phi", &HaldaneModel::phi)
+        .def_readwrite("M", &HaldaneModel::M);
+
+    py::class_<AltermagnetModel, TwoBandModel>(m, "AltermagnetModel")
+        .def(py::init<double, double, double>(),
+             py::arg("t") = 1.0, py::arg("J") = 0.1, py::arg("lam") = 0.2);
+
+    py::class_<KaneMeleModel, Hamiltonian>(m, "KaneMeleModel")
+        .def(py::init<double, double, double, bool>(),
+             py::arg("t") = 1.0, py::arg("lambda_SO") = 0.1, py::arg("lambda_v") = 0.2,
+             py::arg("rashba") = false);
+
+    // -------------------------------------------------------------------- mesh
+    py::class_<Mesh>(m, "Mesh")
+        .def(py::init<size_t, size_t, size_t, double>(),
+             py::arg("nx"), py::arg("ny"), py::arg("nz") = 1, py::arg("kmax") = 2 * M_PI)
+        .def_static("monkhorst_pack", &Mesh::monkhorstPack,
+             py::arg("basis"), py::arg("n1"), py::arg("n2"), py::arg("n3") = 1,
+             py::arg("shift") = Eigen::Vector3d::Zero(),
+             "Monkhorst-Pack mesh of the unit cell spanned by the columns of basis")
+        .def("__len__", &Mesh::size)
+        .def_property_readonly("dimension", &Mesh::dimension)
+        .def_property_readonly("kpoints", [](py::object self) {
+                // Read-only (nk, 3) view of the mesh's own storage; keeps the Mesh alive
+                const Mesh& mesh = self.cast<const Mesh&>();
+                const auto& kpoints = mesh.getKPoints();
+                py::array_t<double> view({py::ssize_t(kpoints.size()), py::ssize_t(3)},
+                                         {py::ssize_t(sizeof(Eigen::Vector3d)), py::ssize_t(sizeof(double))},
+                                         kpoints.empty() ? nullptr : kpoints.front().data(), self);
+                py::detail::array_proxy(view.ptr())->flags &= ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+                return view;
+            })
+        .def_property_readonly("weights", [](py::object self) {
+                // Read-only view of the k-point weights (sum to 1)
+                const auto& weights = self.cast<const Mesh&>().weights();
+                py::array_t<double> view({py::ssize_t(weights.size())}, {py::ssize_t(sizeof(double))},
+                                         weights.data(), self);
+                py::detail::array_proxy(view.ptr())->flags &= ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+                return view;
+            });
+
+    // --------------------------------------------------------------------- DOS
+    py::class_<DOS>(m, "DOS")
+        .def(py::init<const Hamiltonian&, const Mesh&>(), py::arg("H"), py::arg("mesh"),
+             py::keep_alive<1, 2>(), py::keep_alive<1, 3>())
+        .def("compute", [](DOS& dos, double Emin, double Emax, int nBins, double sigma) {
+                std::vector<double> values;
+                {
+                    py::gil_scoped_release release;
+                    values = dos.computeDOS(Emin, Emax, nBins, sigma);
+                }
+                return ownedArray(std::move(values));
+            }, py::arg("Emin"), py::arg("Emax"), py::arg("nBins"), py::arg("sigma"))
+        .def("compute_projected", [](DOS& dos, double Emin, double Emax, int nBins, double eta, int orbital) {
+                std::vector<double> values;
+                {
+                    py::gil_scoped_release release;
+                    values = dos.computeProjectedDOS(Emin, Emax, nBins, eta, orbital);
+                }
+                return ownedArray(std::move(values));
+            }, py::arg("Emin"), py::arg("Emax"), py::arg("nBins"), py::arg("eta"), py::arg("orbital"))
+        .def_property_readonly("energies", [](const DOS& dos) {
+                // Copy of the energy grid of the last computation: the next compute() resizes the grid
+                return ownedArray(std::vector<double>(dos.getEnergyGrid()));
+            });
+
+    // -------------------------------------------------------------------- Kubo
+    py::class_<OpticalConductivity>(m, "OpticalConductivity")
+        .def_readonly("omega", &OpticalConductivity::omega);
+
+    py::class_<KuboSolver>(m, "KuboSolver")
+        .def(py::init<const Hamiltonian&, const Mesh&, double, bool, double>(),
+             py::arg("H"), py::arg("mesh"), py::arg("eta") = 1e-3,
+             py::arg("temperature_in_kelvin") = false, py::arg("energy_scale") = 1.0,
+             py::keep_alive<1, 2>(), py::keep_alive<1, 3>())
+        .def("transport_tensors", [](KuboSolver& solver, double Ef, double T) {
+                Eigen::Matrix3d sigma, alpha, kappa;
+                {
+                    py::gil_scoped_release release;
+                    std::tie(sigma, alpha, kappa) = solver.computeTransportTensors(Ef, T);
+                }
+                return py::make_tuple(ownedArray(Eigen::MatrixXd(sigma)), ownedArray(Eigen::MatrixXd(alpha)),
+                                      ownedArray(Eigen::MatrixXd(kappa)));
+            }, py::arg("Ef"), py::arg("T"), "(sigma, alpha, kappa) as 3x3 arrays")
+        .def("optical_conductivity", [](KuboSolver& solver, const std::vector<double>& omegas, double Ef, double T) {
+                OpticalConductivity result;
+                {
+                    py::gil_scoped_release release;
+                    result = solver.computeOpticalConductivity(omegas, Ef, T);
+                }
+                return py::make_tuple(ownedArray(std::move(result.omega)), stackedTensors(std::move(result.sigma)));
+            }, py::arg("omegas"), py::arg("Ef"), py::arg("T"), "(omega, sigma) with sigma of shape (nω, 3, 3)")
+        .def("response_tensors", [](KuboSolver& solver, const std::vector<Eigen::MatrixXcd>& observables,
+                                    double Ef, double T) {
+                std::vector<Eigen::Matrix3d> result;
+                {
+                    py::gil_scoped_release release;
+                    result = solver.computeResponseTensors(observables, Ef, T);
+                }
+                return stackedTensors(std::move(result));
+            }, py::arg("observables"), py::arg("Ef"), py::arg("T"), "Shape (nobs, 3, 3)");
+
+    // --------------------------------------------------------------- Boltzmann
+    py::class_<TransportDistribution>(m, "TransportDistribution")
+        .def_property_readonly("energies", [](py::object self) {
+                // Read-only view: coefficients() integrates over this grid
+                const auto& e = self.cast<const TransportDistribution&>().energies;
+                py::array_t<double> view({py::ssize_t(e.size())}, {py::ssize_t(sizeof(double))}, e.data(), self);
+                py::detail::array_proxy(view.ptr())->flags &= ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+                return view;
+            })
+        .def("coefficients", [](const TransportDistribution& dist, double Ef, double T) {
+                TransportCoefficients c = dist.coefficients(Ef, T);
+                return py::make_tuple(ownedArray(Eigen::MatrixXd(c.sigma)), ownedArray(Eigen::MatrixXd(c.alpha)),
+                                      ownedArray(Eigen::MatrixXd(c.kappa)));
+            }, py::arg("Ef"), py::arg("T"), "(sigma, alpha, kappa) as 3x3 arrays");
+
+    py::class_<MagnetoTransport>(m, "MagnetoTransport")
+        .def("sigma", [](const MagnetoTransport& mt, const Eigen::Vector3d& B) {
+                return ownedArray(Eigen::MatrixXd(mt.sigma.at(B)));
+            }, py::arg("B"), "sigma(B) as a 3x3 array")
+        .def("alpha", [](const MagnetoTransport& mt, const Eigen::Vector3d& B) {
+                return ownedArray(Eigen::MatrixXd(mt.alpha.at(B)));
+            }, py::arg("B"), "alpha(B) as a 3x3 array")
+        .def("resistivity", [](const MagnetoTransport& mt, const Eigen::Vector3d& B) {
+                return ownedArray(Eigen::MatrixXd(mt.resistivity(B)));
+            }, py::arg("B"), "rho(B) as a 3x3 array")
+        .def("hall_coefficient", &MagnetoTransport::hallCoefficient, py::arg("Bz") = 0.0)
+        .def("magnetoresistance", &MagnetoTransport::magnetoresistance, py::arg("B"), py::arg("direction") = 0);
+
+    py::class_<BoltzmannSolver>(m, "BoltzmannSolver")
+        .def(py::init<const Hamiltonian&, const Mesh&, double, bool, double>(),
+             py::arg("H"), py::arg("mesh"), py::arg("tau"),
+             py::arg("temperature_in_kelvin") = false, py::arg("energy_scale") = 1.0,
+             py::keep_alive<1, 2>(), py::keep_alive<1, 3>())
+        .def("transport_tensors", [](BoltzmannSolver& solver, double Ef, double T,
+                                     const Eigen::Vector3d& gradT, const Eigen::Vector3d& E,
+                                     const Eigen::Vector3d& B) {
+                Eigen::Matrix3d sigma, alpha;
+                {
+                    py::gil_scoped_release release;
+                    std::tie(sigma, alpha) = solver.computeTransportTensors(Ef, T, gradT, E, B);
+                }
+                return py::make_tuple(ownedArray(Eigen::MatrixXd(sigma)), ownedArray(Eigen::MatrixXd(alpha)));
+            }, py::arg("Ef"), py::arg("T"), py::arg("gradT"), py::arg("E"), py::arg("B"))
+        .def("transport_distribution", [](BoltzmannSolver& solver, double Emin, double Emax, size_t nE,
+                                          const Eigen::Vector3d& E, const Eigen::Vector3d& B) {
+                py::gil_scoped_release release;
+                return solver.computeTransportDistribution(Emin, Emax, nE, E, B);
+            }, py::arg("Emin"), py::arg("Emax"), py::arg("nE"), py::arg("E"), py::arg("B"))
+        .def("magneto_transport", [](BoltzmannSolver& solver, double Ef, double T, double dk) {
+                py::gil_scoped_release release;
+                return solver.computeMagnetoTransport(Ef, T, dk);
+            }, py::arg("Ef"), py::arg("T"), py::arg("dk") = 1e-4);
+
+    // ------------------------------------------------------------------- Berry
+    m.def("berry_curvature_fhs", [](const Hamiltonian& H, const Eigen::Vector3d& k, double dk, int band) {
+            return berryCurvatureFHS(H, k, dk, band);
+        }, py::arg("H"), py::arg("k"), py::arg("dk") = 1e-3, py::arg("band") = 0);
+
+    m.def("berry_curvature_map", [](const Hamiltonian& H, const Mesh& mesh, double dk) {
+            Eigen::MatrixXd curvature;
+            {
+                py::gil_scoped_release release;
+                BerryWorkspace ws;
+                curvature = berryCurvatureBatch(H, mesh.getKPoints(), dk, ws);
+            }
+            return ownedArray(std::move(curvature));
+        }, py::arg("H"), py::arg("mesh"), py::arg("dk") = 1e-3,
+        "FHS Berry curvature on every mesh point, shape (nk, nbands)");
+
+    m.def("quantum_geometry_map", [](const Hamiltonian& H, const Mesh& mesh, double dk) {
+            QuantumGeometryMap map;
+            {
+                py::gil_scoped_release release;
+                BerryWorkspace ws;
+                map = quantumGeometryBatch(H, mesh.getKPoints(), mesh.dimension(), dk, ws);
+            }
+            return py::make_tuple(ownedArray(std::move(map.metric)), ownedArray(std::move(map.curvature)));
+        }, py::arg("H"), py::arg("mesh"), py::arg("dk") = 1e-5,
+        "(metric, curvature) of all bands on every mesh point: shapes (nk, 6 nbands) with "
+        "g_xx, g_yy, g_zz, g_xy, g_xz, g_yz per band and (nk, 3 nbands) with Omega_x, Omega_y, Omega_z per band");
+}
@@ -0,0 +1,29 @@
+"""Berry curvature and conductivity of the altermagnet model without CSV round-trips.
+
+Build with -DQT_BUILD_PYTHON=ON and put the build's lib/ directory on PYTHONPATH.
+"""
+import threading
+
+import numpy as np
+import quantumtransport as qt
+
+model = qt.AltermagnetModel(t=1.0, J=0.5, lam=0.1)
+mesh = qt.Mesh(200, 200, 1, np.pi)
+
+k = mesh.kpoints                              # (nk, 3) view of the C++ mesh
+omega = qt.berry_curvature_map(model, mesh)   # (nk, nbands), owned by NumPy
+print("Berry curvature range:", omega[:, 1].min(), omega[:, 1].max())
+
+# Solvers release the GIL: one solver per thread runs concurrently
+results = {}
+
+def run(Ef):
+    solver = qt.KuboSolver(model, mesh, eta=1e-2)
+    results[Ef] = solver.transport_tensors(Ef, 0.02)[0][0, 1]
+
+threads = [threading.Thread(target=run, args=(Ef,)) for Ef in np.linspace(-1.0, 1.0, 4)]
+for t in threads:
+    t.start()
+for t in threads:
+    t.join()
+print({round(Ef, 3): sxy for Ef, sxy in sorted(results.items())})
@@ -0,0 +1,101 @@
+"""Smoke test of the quantumtransport module: calls every binding once on small meshes.
+
+Run through the test_python target (cmake -DQT_BUILD_PYTHON=ON, then make test_python),
+or with the build's lib/ directory on PYTHONPATH. Exits nonzero on the first failure.
+"""
+import sys
+
+import numpy as np
+import quantumtransport as qt
+
+
+def check(name, condition):
+    print(("OK   " if condition else "FAIL ") + name)
+    if not condition:
+        sys.exit(1)
+
+
+def read_only(array):
+    try:
+        array[0] = 0.0
+    except ValueError:
+        return True
+    return False
+
+
+k = np.array([0.3, -0.2, 0.0])
+
+# ------------------------------------------------------------------ models
+haldane = qt.HaldaneModel(t1=1.0, t2=0.1, phi=np.pi / 2, M=0.2)
+haldane.M = 0.25
+check("HaldaneModel parameters are writable", haldane.M == 0.25 and (haldane.t1, haldane.t2) == (1.0, 0.1)
+      and np.isclose(haldane.phi, np.pi / 2))
+altermagnet = qt.AltermagnetModel(t=1.0, J=0.5, lam=0.1)
+kane_mele = qt.KaneMeleModel(t=1.0, lambda_SO=0.06, lambda_v=0.1, rashba=False)
+
+Hk = haldane.Hk(k)
+check("Hk is Hermitian 2x2", Hk.shape == (2, 2) and np.allclose(Hk, Hk.conj().T))
+evals, evecs = haldane.eigensystem(k)
+check("eigensystem diagonalizes Hk", np.allclose(Hk @ evecs, evecs * evals))
+check("eigenvalues match eigensystem", np.allclose(haldane.eigenvalues(k), evals))
+check("reciprocal_basis is 3x3", haldane.reciprocal_basis().shape == (3, 3))
+check("KaneMele has 4 bands", kane_mele.eigenvalues(k).shape == (4,))
+
+energies, velocities, omega = altermagnet.band_geometry(k)
+check("band_geometry shapes", energies.shape == (2,) and velocities.shape == (3, 2) and omega.shape == (2,))
+check("band_geometry energies match eigenvalues", np.allclose(energies, altermagnet.eigenvalues(k)))
+
+# -------------------------------------------------------------------- mesh
+mesh = qt.Mesh(12, 12, 1, np.pi)
+mp = qt.Mesh.monkhorst_pack(haldane.reciprocal_basis(), 12, 12)
+check("mesh length", len(mesh) == 144 and len(mp) == 144)
+check("mesh dimension", mesh.dimension == 2)
+check("kpoints is a read-only (nk, 3) view", mesh.kpoints.shape == (144, 3) and read_only(mesh.kpoints))
+check("weights sum to 1 and are read-only", np.isclose(mp.weights.sum(), 1.0) and read_only(mp.weights))
+
+bands = haldane.bands(mp)
+check("bands shape", bands.shape == (144, 2))
+
+# --------------------------------------------------------------------- DOS
+dos = qt.DOS(haldane, mp)
+values = dos.compute(-4.0, 4.0, 50, 0.1)
+grid = dos.energies
+check("DOS and grid sizes", values.shape == (50,) and grid.shape == (50,))
+dos.compute_projected(-4.0, 4.0, 80, 0.1, 0)
+check("DOS.energies is a copy that survives the next compute", grid.shape == (50,) and dos.energies.shape == (80,))
+
+# -------------------------------------------------------------------- Kubo
+kubo = qt.KuboSolver(haldane, mp, eta=1e-2)
+sigma, alpha, kappa = kubo.transport_tensors(0.0, 0.01)
+check("Kubo tensors are 3x3", sigma.shape == alpha.shape == kappa.shape == (3, 3))
+omegas, optical = kubo.optical_conductivity([0.0, 0.5, 1.0], 0.0, 0.01)
+check("optical conductivity shape", omegas.shape == (3,) and optical.shape == (3, 3, 3))
+response = kubo.response_tensors([np.eye(2, dtype=complex)], 0.0, 0.01)
+check("response tensor shape", response.shape == (1, 3, 3))
+
+# --------------------------------------------------------------- Boltzmann
+zero = np.zeros(3)
+boltzmann = qt.BoltzmannSolver(altermagnet, mp, tau=1.0)
+sigma, alpha = boltzmann.transport_tensors(0.5, 0.01, zero, zero, zero)
+check("Boltzmann tensors are 3x3", sigma.shape == alpha.shape == (3, 3))
+
+distribution = boltzmann.transport_distribution(-4.0, 4.0, 200, zero, zero)
+check("distribution grid is read-only", distribution.energies.shape == (200,) and read_only(distribution.energies))
+sigma, alpha, kappa = distribution.coefficients(0.5, 0.01)
+check("distribution coefficients are 3x3", sigma.shape == alpha.shape == kappa.shape == (3, 3))
+
+magneto = boltzmann.magneto_transport(0.5, 0.01)
+B = np.array([0.0, 0.0, 0.1])
+check("magnetotransport tensors are 3x3",
+      magneto.sigma(B).shape == magneto.alpha(B).shape == magneto.resistivity(B).shape == (3, 3))
+check("magnetotransport scalars are finite",
+      np.isfinite(magneto.hall_coefficient(0.1)) and np.isfinite(magneto.magnetoresistance(B, 0)))
+
+# ------------------------------------------------------------------- Berry
+curvature = qt.berry_curvature_map(haldane, mp)
+check("Berry curvature map shape", curvature.shape == (144, 2))
+check("FHS matches the map", np.isclose(qt.berry_curvature_fhs(haldane, mp.kpoints[5], 1e-3, 0), curvature[5, 0]))
+metric, omega_map = qt.quantum_geometry_map(haldane, mp)
+check("quantum geometry shapes", metric.shape == (144, 12) and omega_map.shape == (144, 6))
+
+print("All bindings OK")
@@ -0,0 +1,257 @@
+#include "band_interpolation.hpp"
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+
+/// @file band_interpolation.cpp
+/// @brief Coarse-grid diagonalization, Fourier fit and dense-grid evaluation behind BandInterpolator.
+
+/// @brief Lattice indices for an axis with n grid points, with their star weights
+/// @details Odd n uses -(n-1)/2 .. (n-1)/2. Even n adds both Nyquist indices ±n/2 with
+/// weight 1/2, which keeps the interpolant real and symmetric.
+static void axisIndices(size_t n, std::vector<int>& R, std::vector<double>& weight) {
+    const int half = static_cast<int>(n / 2);
+    const bool even = (n % 2 == 0);
+    R.clear();
+    weight.clear();
+    for (int m = -half; m <= half; ++m) {
+        R.push_back(m);
+        weight.push_back((even && std::abs(m) == half) ? 0.5 : 1.0);
+    }
+}
+
+
+BandInterpolator::BandInterpolator(const Hamiltonian& H, size_t n1, size_t n2, size_t n3)
+    : n_{n1, n2, n3} {
+
+    if (n1 == 0 || n2 == 0 || n3 == 0) {
+        throw std::invalid_argument("BandInterpolator: grid sizes must be positive");
+    }
+
+    basis_ = H.reciprocalBasis();
+    reducedFromCartesian_ = basis_.inverse();
+    gradientToCartesian_ = reducedFromCartesian_.transpose();
+
+    // 1. Diagonalize the coarse grid k = Σ_d (m_d / n_d) b_d
+    const size_t ncoarse = coarseSize();
+    Eigen::MatrixXd bands;
+    EigenWorkspace ws;
+
+    size_t iq = 0;
+    for (size_t i = 0; i < n1; ++i) {
+        for (size_t j = 0; j < n2; ++j) {
+            for (size_t l = 0; l < n3; ++l, ++iq) {
+                const Eigen::Vector3d reduced(double(i) / n1, double(j) / n2, double(l) / n3);
+                H.eigenvalues(basis_ * reduced, ws);
+                if (iq == 0) bands.resize(static_cast<Eigen::Index>(ncoarse), ws.evals.size());
+                bands.row(static_cast<Eigen::Index>(iq)) = ws.evals.transpose();
+            }
+        }
+    }
+
+    // 2. Lattice indices and star weights per axis
+    std::array<std::vector<double>, 3> axisWeight;
+    std::array<Eigen::Index, 3> m;
+    for (int d = 0; d < 3; ++d) {
+        axisIndices(n_[d], axisR_[d], axisWeight[d]);
+        m[d] = static_cast<Eigen::Index>(axisR_[d].size());
+        if (n_[d] > 1) activeAxes_.push_back(d);
+    }
+
+    // 3. Discrete Fourier transform c_nR = w_R / N Σ_q ε_n(q) exp(-2πi f_q·R), one axis at a time:
+    //    F_d(m, q) = w_m exp(-2πi q R_m / n_d) / n_d; planes of fixed q_1 first, then along axis 1
+    std::array<Eigen::MatrixXcd, 3> forward;
+    for (int d = 0; d < 3; ++d) {
+        forward[d].resize(m[d], static_cast<Eigen::Index>(n_[d]));
+        for (Eigen::Index r = 0; r < m[d]; ++r) {
+            for (size_t q = 0; q < n_[d]; ++q) {
+                const double arg = -2.0 * M_PI * double(q) * axisR_[d][static_cast<size_t>(r)] / double(n_[d]);
+                forward[d](r, static_cast<Eigen::Index>(q)) = axisWeight[d][static_cast<size_t>(r)] / double(n_[d])
+                                                            * std::polar(1.0, arg);
+            }
+        }
+    }
+
+    const Eigen::Index nb = bands.cols();
+    const Eigen::Index plane = m[1] * m[2];
+    Eigen::MatrixXcd planes(plane * nb, static_cast<Eigen::Index>(n1));
+    Eigen::MatrixXd slice(static_cast<Eigen::Index>(n2), static_cast<Eigen::Index>(n3));
+    for (size_t i = 0; i < n1; ++i) {
+        for (Eigen::Index n = 0; n < nb; ++n) {
+            for (size_t j = 0; j < n2; ++j) {
+                for (size_t l = 0; l < n3; ++l) {
+                    slice(static_cast<Eigen::Index>(j), static_cast<Eigen::Index>(l)) =
+                        bands(static_cast<Eigen::Index>((i * n2 + j) * n3 + l), n);
+                }
+            }
+            Eigen::Map<Eigen::MatrixXcd>(planes.col(static_cast<Eigen::Index>(i)).data() + n * plane, m[1], m[2]) =
+                forward[1] * slice.cast<std::complex<double>>() * forward[2].transpose();
+        }
+    }
+    fourier_ = forward[0] * planes.transpose();
+
+    // 4. Real series for evaluate: keep one R of each ±R pair (lexicographically non-negative half,
+    //    R = 0 once) as ε_n = Σ_R a_nR cos θ_R + b_nR sin θ_R with a = 2 Re c, b = -2 Im c (a = c for R = 0)
+    std::vector<Eigen::Vector3i> positions;
+    for (Eigen::Index a = 0; a < m[0]; ++a) {
+        for (Eigen::Index b = 0; b < m[1]; ++b) {
+            for (Eigen::Index c = 0; c < m[2]; ++c) {
+                const Eigen::Vector3i R(axisR_[0][a], axisR_[1][b], axisR_[2][c]);
+                const bool positive = R(0) > 0 || (R(0) == 0 && (R(1) > 0 || (R(1) == 0 && R(2) >= 0)));
+                if (positive) positions.emplace_back(int(a), int(b), int(c));
+            }
+        }
+    }
+
+    const Eigen::Index nR = static_cast<Eigen::Index>(positions.size());
+    R_.resize(3, nR);
+    Rreal_.resize(3, nR);
+    coefficients_.resize(nb, 2 * nR);
+    for (Eigen::Index r = 0; r < nR; ++r) {
+        R_.col(r) = positions[static_cast<size_t>(r)];
+        for (int d = 0; d < 3; ++d) Rreal_(d, r) = axisR_[d][static_cast<size_t>(R_(d, r))];
+        const double scale = Rreal_.col(r).isZero() ? 1.0 : 2.0;
+        for (Eigen::Index n = 0; n < nb; ++n) {
+            const std::complex<double> c = fourier_(R_(0, r), R_(1, r) + m[1] * (R_(2, r) + m[2] * n));
+            coefficients_(n, r) = scale * c.real();
+            coefficients_(n, nR + r) = -scale * c.imag();
+        }
+    }
+}
+
+
+void BandInterpolator::computeBasis(const Eigen::Vector3d& k, InterpolationWorkspace& ws) const {
+    const Eigen::Vector3d f = reducedFromCartesian_ * k;
+
+    // exp(2πi f·R) factorizes into one small table per axis
+    for (int d = 0; d < 3; ++d) {
+        const Eigen::Index nm = static_cast<Eigen::Index>(axisR_[d].size());
+        ws.axisPhase[d].resize(nm);
+        for (Eigen::Index m = 0; m < nm; ++m) {
+            const double arg = 2.0 * M_PI * f(d) * axisR_[d][static_cast<size_t>(m)];
+            ws.axisPhase[d](m) = std::complex<double>(std::cos(arg), std::sin(arg));
+        }
+    }
+
+    // Column 0: [cos θ; sin θ]. Column 1 + a: ∂/∂f_d of column 0 divided by 2π, i.e. [-R_d sin θ; R_d cos θ]
+    const Eigen::Index nR = R_.cols();
+    const Eigen::Index naxes = static_cast<Eigen::Index>(activeAxes_.size());
+    ws.basis.resize(2 * nR, 1 + naxes);
+    for (Eigen::Index r = 0; r < nR; ++r) {
+        const std::complex<double> phase =
+            ws.axisPhase[0](R_(0, r)) * ws.axisPhase[1](R_(1, r)) * ws.axisPhase[2](R_(2, r));
+        ws.basis(r, 0) = phase.real();
+        ws.basis(nR + r, 0) = phase.imag();
+        for (Eigen::Index a = 0; a < naxes; ++a) {
+            const double Rd = Rreal_(activeAxes_[static_cast<size_t>(a)], r);
+            ws.basis(r, 1 + a) = -Rd * phase.imag();
+            ws.basis(nR + r, 1 + a) = Rd * phase.real();
+        }
+    }
+}
+
+
+void BandInterpolator::evaluate(const Eigen::Vector3d& k, InterpolationWorkspace& ws,
+                                Eigen::VectorXd& energies, Eigen::MatrixXd& velocities) const {
+    computeBasis(k, ws);
+
+    // One product gives ε_n and ∂ε_n/∂f_d / 2π for all bands
+    ws.values.resize(coefficients_.rows(), ws.basis.cols());
+    ws.values.noalias() = coefficients_ * ws.basis;
+
+    const Eigen::Index nb = coefficients_.rows();
+    energies.resize(nb);
+    energies = ws.values.col(0);
+
+    // ∇_k ε = B⁻ᵀ ∇_f ε (inactive axes have no dependence on f_d)
+    velocities.setZero(3, nb);
+    for (size_t a = 0; a < activeAxes_.size(); ++a) {
+        velocities += 2.0 * M_PI * gradientToCartesian_.col(activeAxes_[a])
+                    * ws.values.col(static_cast<Eigen::Index>(1 + a)).transpose();
+    }
+}
+
+
+Eigen::VectorXd BandInterpolator::energies(const Eigen::Vector3d& k) const {
+    InterpolationWorkspace ws;
+    Eigen::VectorXd e;
+    Eigen::MatrixXd v;
+    evaluate(k, ws, e, v);
+    return e;
+}
+
+
+bool BandInterpolator::supportsGrid(const Mesh& dense) const {
+    return dense.isMonkhorstPack() && dense.basis().isApprox(basis_, 1e-12);
+}
+
+
+void BandInterpolator::evaluateGrid(const Mesh& dense, size_t begin, size_t end,
+                                    Eigen::MatrixXd& energies, std::array<Eigen::MatrixXd, 3>& velocities) const {
+    if (!supportsGrid(dense)) {
+        throw std::invalid_argument("BandInterpolator::evaluateGrid: need a Monkhorst-Pack mesh of the model's reciprocal basis");
+    }
+    if (begin > end || end > dense.size()) {
+        throw std::invalid_argument("BandInterpolator::evaluateGrid: range exceeds the mesh");
+    }
+
+    const std::array<size_t, 3> D = dense.gridSize();
+    const Eigen::Index nb = coefficients_.rows();
+    std::array<Eigen::Index, 3> m;
+    for (int d = 0; d < 3; ++d) m[d] = static_cast<Eigen::Index>(axisR_[d].size());
+
+    // Phase tables P_d(i, r) = exp(2πi f_i R_r) on the dense axis and their f-derivatives 2πi R_r P_d
+    std::array<Eigen::MatrixXcd, 3> P, dP;
+    for (int d = 0; d < 3; ++d) {
+        P[d].resize(static_cast<Eigen::Index>(D[d]), m[d]);
+        dP[d].resize(static_cast<Eigen::Index>(D[d]), m[d]);
+        for (size_t i = 0; i < D[d]; ++i) {
+            const double f = (double(i) + dense.shift()(d)) / double(D[d]);
+            for (Eigen::Index r = 0; r < m[d]; ++r) {
+                const double R = axisR_[d][static_cast<size_t>(r)];
+                const std::complex<double> phase = std::polar(1.0, 2.0 * M_PI * f * R);
+                P[d](static_cast<Eigen::Index>(i), r) = phase;
+                dP[d](static_cast<Eigen::Index>(i), r) = std::complex<double>(0.0, 2.0 * M_PI * R) * phase;
+            }
+        }
+    }
+
+    energies.resize(static_cast<Eigen::Index>(end - begin), nb);
+    for (auto& v : velocities) v.resize(static_cast<Eigen::Index>(end - begin), nb);
+    if (begin == end) return;
+
+    // Per plane of fixed dense index i: sum over R_1, then R_2 for all bands at once, then R_3 per band
+    const size_t plane = D[1] * D[2];
+    Eigen::RowVectorXcd g, g1;
+    Eigen::MatrixXcd A, A1, A2;
+    std::array<Eigen::MatrixXcd, 4> out; // ε and ∂ε/∂f_d on the plane (D_2 x D_3)
+    for (size_t i = begin / plane; i <= (end - 1) / plane; ++i) {
+        g.noalias() = P[0].row(static_cast<Eigen::Index>(i)) * fourier_;
+        g1.noalias() = dP[0].row(static_cast<Eigen::Index>(i)) * fourier_;
+        const Eigen::Map<const Eigen::MatrixXcd> G(g.data(), m[1], m[2] * nb), G1(g1.data(), m[1], m[2] * nb);
+        A.noalias() = P[1] * G;
+        A1.noalias() = P[1] * G1;
+        A2.noalias() = dP[1] * G;
+
+        for (Eigen::Index n = 0; n < nb; ++n) {
+            out[0].noalias() = A.middleCols(n * m[2], m[2]) * P[2].transpose();
+            out[1].noalias() = A1.middleCols(n * m[2], m[2]) * P[2].transpose();
+            out[2].noalias() = A2.middleCols(n * m[2], m[2]) * P[2].transpose();
+            out[3].noalias() = A.middleCols(n * m[2], m[2]) * dP[2].transpose();
+
+            for (size_t j = 0; j < D[1]; ++j) {
+                for (size_t l = 0; l < D[2]; ++l) {
+                    const size_t ik = i * plane + j * D[2] + l;
+                    if (ik < begin || ik >= end) continue;
+                    const Eigen::Index row = static_cast<Eigen::Index>(ik - begin);
+                    const Eigen::Index jj = static_cast<Eigen::Index>(j), ll = static_cast<Eigen::Index>(l);
+                    energies(row, n) = out[0](jj, ll).real();
+                    // ∇_k ε = B⁻ᵀ ∇_f ε
+                    const Eigen::Vector3d grad_f(out[1](jj, ll).real(), out[2](jj, ll).real(), out[3](jj, ll).real());
+                    const Eigen::Vector3d grad_k = gradientToCartesian_ * grad_f;
+                    for (int c = 0; c < 3; ++c) velocities[c](row, n) = grad_k(c);
+                }
+            }
+        }
+    }
+}
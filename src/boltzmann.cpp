@@ -1,6 +1,10 @@
 #include "boltzmann.hpp"
+#include "distributed.hpp"
+#include <algorithm>
 #include <cmath>
+#include <complex>
 #include <iostream>
+#include <stdexcept>
 
 
 /// @brief Fermi-Dirac distribution function
@@ -23,39 +27,146 @@ inline double fermi_derivative(double e, double Ef, double T,
 };
 
 
-Eigen::Matrix3d BoltzmannSolver::secondDerivatives(const Eigen::Vector3d& k, 
+void BoltzmannSolver::firstDerivativeH(const Eigen::Vector3d& k, int i, double dk,
+                                       Eigen::MatrixXcd& out) const {
+    if (H.dHdk(k, i, out)) return;
+    Eigen::Vector3d step = Eigen::Vector3d::Zero();
+    step(i) = dk;
+    H.Hk(k + step, ws_plus.Hk);
+    H.Hk(k - step, ws_minus.Hk);
+    out = (ws_plus.Hk - ws_minus.Hk) / (2.0 * dk);
+}
+
+void BoltzmannSolver::secondDerivativeH(const Eigen::Vector3d& k, int i, int j, double dk,
+                                        Eigen::MatrixXcd& out) const {
+    if (H.d2Hdk2(k, i, j, out)) return;
+    Eigen::Vector3d step = Eigen::Vector3d::Zero();
+    step(j) = dk;
+    firstDerivativeH(k + step, i, dk, dH_plus);
+    firstDerivativeH(k - step, i, dk, dH_minus);
+    out = (dH_plus - dH_minus) / (2.0 * dk);
+}
+
+
+/// @brief Band velocities and Hessians by perturbation theory, restricted to the first Dim directions
+template <int Dim>
+void BoltzmannSolver::bandHessiansImpl(const Eigen::Vector3d& k, const EigenWorkspace& eig, double dk,
+                                       Eigen::MatrixXd& velocities,
+                                       std::vector<Eigen::Matrix3d>& hessians) const {
+    const Eigen::MatrixXcd& U = eig.evecs;
+    const Eigen::VectorXd& evals = eig.evals;
+    const Eigen::Index nb = evals.size();
+
+    // dH_eigenbasis[i] = U^† ∂_i H U, so that <m|∂_i H|n> is entry (m, n)
+    for (int i = 0; i < Dim; ++i) {
+        firstDerivativeH(k, i, dk, dH_analytic[i]);
+        dH_eigenbasis[i].noalias() = U.adjoint() * dH_analytic[i] * U;
+    }
+
+    velocities.setZero(3, nb);
+    hessians.assign(static_cast<size_t>(nb), Eigen::Matrix3d::Zero());
+    for (int i = 0; i < Dim; ++i) {
+        velocities.row(i) = dH_eigenbasis[i].diagonal().real().transpose();
+    }
+
+    for (int i = 0; i < Dim; ++i) {
+        for (int j = i; j < Dim; ++j) {
+            secondDerivativeH(k, i, j, dk, d2H_buffer);
+            for (Eigen::Index n = 0; n < nb; ++n) {
+                double h = U.col(n).dot(d2H_buffer * U.col(n)).real();
+                for (Eigen::Index m = 0; m < nb; ++m) {
+                    const double gap = evals(n) - evals(m);
+                    if (m == n || std::abs(gap) < 1e-8) continue; // skip degenerate partners
+                    h += 2.0 * std::real(dH_eigenbasis[i](n, m) * dH_eigenbasis[j](m, n)) / gap;
+                }
+                hessians[n](i, j) = h;
+                hessians[n](j, i) = h;
+            }
+        }
+    }
+}
+
+
+void BoltzmannSolver::bandHessians(const Eigen::Vector3d& k, const EigenWorkspace& eig, double dk,
+                                   Eigen::MatrixXd& velocities,
+                                   std::vector<Eigen::Matrix3d>& hessians) const {
+    if (mesh.dimension() == 2) return bandHessiansImpl<2>(k, eig, dk, velocities, hessians);
+    return bandHessiansImpl<3>(k, eig, dk, velocities, hessians);
+}
+
+
+Eigen::Matrix3d BoltzmannSolver::secondDerivatives(const Eigen::Vector3d& k,
                                                     int band, double dk) const {
+    H.eigensystem(k, eig_ws);
+    bandHessians(k, eig_ws, dk, hess_velocities, hess_buffer);
+    return hess_buffer[band];
+}
+
+
+
+template <int Dim>
+void BoltzmannSolver::bandGeometryImpl(const Eigen::Vector3d& k, double dk) const {
+    Eigen::VectorXd& evals = eig_ws.evals;
 
-    Eigen::Matrix3d hessian = Eigen::Matrix3d::Zero();
-    Eigen::Vector3d dki, dkj;
-
-    for (int i = 0; i < 3; ++i) {
-        for (int j = i; j < 3; ++j) {
-            dki = Eigen::Vector3d::Zero();
-            dkj = Eigen::Vector3d::Zero();
-            dki(i) = dk;
-            dkj(j) = dk;
-
-            double epp, epm, emp, emm;
-
-            H.eigensystem(k + dki + dkj, evals_plus, evecs_dummy);
-            epp = evals_plus(band);
-            H.eigensystem(k + dki - dkj, evals_plus, evecs_dummy);
-            epm = evals_plus(band);
-            H.eigensystem(k - dki + dkj, evals_plus, evecs_dummy);
-            emp = evals_plus(band);
-            H.eigensystem(k - dki - dkj, evals_plus, evecs_dummy);
-            emm = evals_plus(band);
-
-            double second_derivative = (epp - epm - emp + emm) / (4.0 * dk * dk);
-            hessian(i, j) = second_derivative;
-            hessian(j, i) = second_derivative;
+    if (two_band) {
+        TwoBandGeometry geometry;
+        two_band->bandGeometry(k, geometry);
+        evals = geometry.energies;
+        geom_velocities.setZero(3, 2);
+        geom_velocities.topRows<Dim>() = geometry.velocities.topRows<Dim>();
+        geom_omega = geometry.omega;
+        return;
+    }
+
+    bool analytic = true;
+    for (int i = 0; i < Dim && analytic; ++i) analytic = H.dHdk(k, i, dH_analytic[i]);
+
+    if (!analytic) {
+        // Central differences of all band energies, FHS plaquette for all bands
+        H.eigenvalues(k, eig_ws);
+        geom_velocities.setZero(3, evals.size());
+        for (int dim = 0; dim < Dim; ++dim) {
+            Eigen::Vector3d dk_vec = Eigen::Vector3d::Zero();
+            dk_vec(dim) = dk;
+            H.eigenvalues(k + dk_vec, ws_plus);
+            H.eigenvalues(k - dk_vec, ws_minus);
+            geom_velocities.row(dim) = ((ws_plus.evals - ws_minus.evals) / (2.0 * dk)).transpose();
         }
+        berryCurvatureFHSAllBands(H, k, 1e-3, berry_ws, geom_omega);
+        return;
     }
 
-    return hessian;
-};
+    H.eigensystem(k, eig_ws);
+    const Eigen::MatrixXcd& U = eig_ws.evecs;
+    const Eigen::Index nb = evals.size();
+
+    // dH_eigenbasis[i] = U^† ∂_i H U, so that <m|∂_i H|n> is entry (m, n)
+    geom_velocities.setZero(3, nb);
+    for (int i = 0; i < Dim; ++i) {
+        dH_product.noalias() = dH_analytic[i] * U;
+        dH_eigenbasis[i].noalias() = U.adjoint() * dH_product;
+        geom_velocities.row(i) = dH_eigenbasis[i].diagonal().real().transpose();
+    }
+
+    // Band window (fewer eigenvectors than orbitals): the sum over states would miss the bands
+    // outside it, so take Ω of each window band from its own FHS plaquette instead
+    if (U.cols() < U.rows()) {
+        berryCurvatureFHSAllBands(H, k, 1e-3, berry_ws, geom_omega);
+        return;
+    }
 
+    geom_omega.setZero(nb);
+    for (Eigen::Index n = 0; n < nb; ++n) {
+        std::complex<double> sum = 0.0;
+        for (Eigen::Index m = 0; m < nb; ++m) {
+            const double gap = evals(n) - evals(m);
+            if (m == n || std::abs(gap) < 1e-8) continue; // skip degenerate partners
+            sum += dH_eigenbasis[0](n, m) * dH_eigenbasis[1](m, n) / (gap * gap);
+        }
+        // Sign convention of berryCurvatureFHS, which the finite-difference path uses
+        geom_omega(n) = 2.0 * std::imag(sum);
+    }
+}
 
 
 /// @brief Calculate the group velocity and anomalous velocity at a given k-point
@@ -65,33 +176,28 @@ Eigen::Matrix3d BoltzmannSolver::secondDerivatives(const Eigen::Vector3d& k,
 /// @param B magnetic field vector
 /// @param dk small displacement in k-space for numerical differentiation
 /// @return    VelocityResult containing group velocity and phase-space factor
-VelocityResult BoltzmannSolver::velocity(
+/// @details Evaluates the geometry of all bands at k (see bandGeometryImpl) and picks one;
+/// the mesh loops call bandGeometryImpl once per k-point instead.
+template <int Dim>
+VelocityResult BoltzmannSolver::velocityImpl(
                     double energy, double Ef, double T,
                     const Eigen::Vector3d& k, int band,
                     const Eigen::Vector3d& gradT,
                     const Eigen::Vector3d& E, 
                     const Eigen::Vector3d& B,  
                     double dk) const {
-    
-    Eigen::Vector3d v_group;
-
-    for (int dim = 0; dim < 3; ++dim) {
-        Eigen::Vector3d dk_vec = Eigen::Vector3d::Zero();
-        dk_vec(dim) = dk; // Perturb in the current dimension
-
-        //Eigen::VectorXd evals_plus, evals_minus;
-        //Eigen::MatrixXcd evecs_dummy;
-
-        H.eigensystem(k + dk_vec, evals_plus, evecs_dummy);
-        H.eigensystem(k - dk_vec, evals_minus, evecs_dummy);
-
-        v_group(dim) = (evals_plus(band) - evals_minus(band)) / (2.0 * dk);
-    }
+    bandGeometryImpl<Dim>(k, dk);
+    return fieldVelocity(energy, Ef, T, geom_velocities.col(band), Eigen::Vector3d(0, 0, geom_omega(band)),
+                         gradT, E, B);
+};
 
-    // Get Berry curvature for band
-    const double omega_z = berryCurvatureFHS(H, k, 1e-3, band); 
-    const Eigen::Vector3d omega(0, 0, omega_z);
 
+VelocityResult BoltzmannSolver::fieldVelocity(double energy, double Ef, double T,
+                                              const Eigen::Vector3d& v_group,
+                                              const Eigen::Vector3d& omega,
+                                              const Eigen::Vector3d& gradT,
+                                              const Eigen::Vector3d& E,
+                                              const Eigen::Vector3d& B) {
     // 3. Phase-space factor (D_n = 1 + B·Ω_n)
     double D_n = 1.0 + B.dot(omega);
     if (D_n <= 0.0) D_n = 1.0; // Fallback if unphysical
@@ -110,7 +216,19 @@ VelocityResult BoltzmannSolver::velocity(
     result.velocity = (v_group + v_anomalous + v_lorentz + v_gradT) / D_n;
     result.phaseSpaceFactor = D_n;
     return result;
-};
+}
+
+
+VelocityResult BoltzmannSolver::velocity(
+                    double energy, double Ef, double T,
+                    const Eigen::Vector3d& k, int band,
+                    const Eigen::Vector3d& gradT,
+                    const Eigen::Vector3d& E,
+                    const Eigen::Vector3d& B,
+                    double dk) const {
+    if (mesh.dimension() == 2) return velocityImpl<2>(energy, Ef, T, k, band, gradT, E, B, dk);
+    return velocityImpl<3>(energy, Ef, T, k, band, gradT, E, B, dk);
+}
 
 
 
@@ -125,63 +243,342 @@ BoltzmannSolver::computeTransportTensors(double Ef, double T,
                                         const Eigen::Vector3d& gradT,
                                         const Eigen::Vector3d& Efield,
                                         const Eigen::Vector3d& Bfield) const {
+    if (mesh.dimension() == 2) return computeTransportTensorsImpl<2>(Ef, T, gradT, Efield, Bfield);
+    return computeTransportTensorsImpl<3>(Ef, T, gradT, Efield, Bfield);
+}
+
+
+/// @brief Shared per-state kernel of the mesh and interpolated transport paths
+void BoltzmannSolver::accumulateState(double energy, double Ef, double T,
+                                      const Eigen::Vector3d& v, double D_n,
+                                      Eigen::Matrix3d& sigma, Eigen::Matrix3d& alpha) const {
+    const double dfde = -fermi_derivative(energy, Ef, T,
+                                          temperature_in_kelvin,
+                                          energy_scale);
+
+    const Eigen::Matrix3d vvT = v * v.transpose(); // Reuse for both tensors
+
+    // σ_ij = e²τ ∑ D_n (-∂f/∂E) v_i v_j
+    sigma += tau * D_n * dfde * vvT;
+
+    // α_ij = -eτ ∑ D_n (-∂f/∂E) (E-Ef)/T v_i v_j
+    alpha += tau * D_n * dfde * ((energy - Ef) / T) * vvT;
+}
+
+
+template <int Dim>
+std::tuple<Eigen::Matrix3d, Eigen::Matrix3d>
+BoltzmannSolver::computeTransportTensorsImpl(double Ef, double T,
+                                            const Eigen::Vector3d& gradT,
+                                            const Eigen::Vector3d& Efield,
+                                            const Eigen::Vector3d& Bfield) const {
     
     Eigen::Matrix3d sigma = Eigen::Matrix3d::Zero();
     Eigen::Matrix3d alpha = Eigen::Matrix3d::Zero();
-    const double norm = 1.0 / mesh.size();
-    const double e = 1.0;           // unit charge (in units of e)
-    const double hbar = 1.0;        // assume ℏ = 1 in natural units or scale appropriately
-    const double dk = 1e-2;  // step size in momentum space for second derivatives
-
-
-    for (const auto& k : mesh.getKPoints()) {
-        //Eigen::VectorXd evals;
-        //Eigen::MatrixXcd evecs;
-        H.eigensystem(k, evals, evecs);
+    const std::vector<double>& weights = mesh.weights(); // k-point weights (sum to 1)
+
+    // Each MPI rank sums over its own block of the mesh (the whole mesh without MPI)
+    const auto& kpoints = mesh.getKPoints();
+    const auto [k_begin, k_end] = Distributed::localRange(kpoints.size());
+
+    if (progress) progress->start(k_end - k_begin);
+    for (size_t ik = k_begin; ik < k_end; ++ik) {
+        if (progress) progress->add();
+        const auto& k = kpoints[ik];
+        bandGeometryImpl<Dim>(k);
+        const Eigen::VectorXd& evals = eig_ws.evals;
         
         for (int band = 0; band < evals.size(); ++band) {
             const double energy       = evals(band);
-            const double dfde         = -fermi_derivative(energy, Ef, T, 
-                                                    temperature_in_kelvin, 
-                                                    energy_scale);
 
-            VelocityResult vres = velocity(energy, Ef, T, k, band, gradT, Efield, Bfield); // <-- returns velocity & D_n
-            Eigen::Vector3d v = vres.velocity;
-            double D_n = vres.phaseSpaceFactor;
+            const Eigen::Vector3d omega(0, 0, geom_omega(band));
+            VelocityResult vres = fieldVelocity(energy, Ef, T, geom_velocities.col(band), omega, gradT, Efield, Bfield);
+            accumulateState(energy, Ef, T, vres.velocity, weights[ik] * vres.phaseSpaceFactor, sigma, alpha);
+        }
+    }
+    if (progress) progress->finish();
 
-            Eigen::Matrix3d vvT = v * v.transpose(); // Reuse for both tensors
+    Distributed::sumAll(sigma);
+    Distributed::sumAll(alpha);
+
+    return {sigma, alpha};
+}
 
-        
-           // σ_ij = e²τ ∑ D_n (-∂f/∂E) v_i v_j
-            sigma += tau * D_n * dfde  * vvT;
 
-            // α_ij = -eτ ∑ D_n (-∂f/∂E) (E-Ef)/T v_i v_j
-            alpha += tau * D_n * dfde  * ((energy - Ef) / T) * vvT;
+MagnetoTransport BoltzmannSolver::computeMagnetoTransport(double Ef, double T, double dk) const {
+    if (mesh.dimension() == 2) return computeMagnetoTransportImpl<2>(Ef, T, dk);
+    return computeMagnetoTransportImpl<3>(Ef, T, dk);
+}
 
-            /*
-            // 2. B·correction terms (second order in τ)
-            if (Bfield.norm() > 1e-12) {
-                Eigen::Matrix3d hess = secondDerivatives(k, band, dk);
 
-                // Assuming B = (0, 0, Bz) only
-                double Bz = Bfield.z();
+template <int Dim>
+MagnetoTransport BoltzmannSolver::computeMagnetoTransportImpl(double Ef, double T, double dk) const {
+    MagnetoTransport result;
+    result.dimension = Dim;
+    const std::vector<double>& weights = mesh.weights();
+    const double kT = temperature_in_kelvin ? 8.617333262e-5 * T / energy_scale : T;
 
-                Eigen::Vector3d C;
-                C.x() = -v.x() * hess(0,1) + v.y() * hess(0,0);  // -vx ∂xy ε + vy ∂xx ε
-                C.y() = -v.x() * hess(0,1) + v.y() * hess(0,0);  // same as x in 2D symmetry
-                C.z() = 0.0;
+    // Coefficients of all orders in one buffer, so the MPI reduction is a single call:
+    // column 0 = σ0, 1..3 = σ1[c], 4..12 = σ2[3c + d], then the same 13 columns for α
+    Eigen::MatrixXd terms = Eigen::MatrixXd::Zero(9, 26);
 
-                double prefactor = -std::pow(e, 3) * std::pow(tau, 2) * Bz / std::pow(hbar, 3);
-                sigma += prefactor * dfde * (v * C.transpose());
+    const auto& kpoints = mesh.getKPoints();
+    const auto [k_begin, k_end] = Distributed::localRange(kpoints.size());
 
-                double energyShift = (energy - Ef) / T;
-                double alphaPrefactor = prefactor * energyShift;
-                alpha += alphaPrefactor * dfde * (v * C.transpose());
+    if (progress) progress->start(k_end - k_begin);
+    for (size_t ik = k_begin; ik < k_end; ++ik) {
+        if (progress) progress->add();
+        const auto& k = kpoints[ik];
+        H.eigensystem(k, eig_ws);
+        const Eigen::VectorXd& evals = eig_ws.evals;
+
+        // Skip k-points without states in the thermal window (-∂f/∂E < 1e-17 / kT)
+        if (((evals.array() - Ef).abs() > 40.0 * kT).all()) continue;
+        bandHessiansImpl<Dim>(k, eig_ws, dk, hess_velocities, hess_buffer);
+
+        for (int band = 0; band < evals.size(); ++band) {
+            const double energy = evals(band);
+            if (std::abs(energy - Ef) > 40.0 * kT) continue;
+
+            const double dfde = -fermi_derivative(energy, Ef, T, temperature_in_kelvin, energy_scale);
+            const Eigen::Vector3d v = hess_velocities.col(band);
+            const Eigen::Matrix3d& mass = hess_buffer[band];
+
+            // L_c v = ((v × e_c)·∇_k) v = M (v × e_c) for a unit field along c
+            Eigen::Matrix3d Lv;
+            for (int c = 0; c < 3; ++c) Lv.col(c) = mass * v.cross(Eigen::Vector3d::Unit(c));
+
+            const double w = weights[ik] * dfde;
+            const double shift = (energy - Ef) / T;
+            auto add = [&](Eigen::Index column, const Eigen::Matrix3d& contribution) {
+                const Eigen::Map<const Eigen::Matrix<double, 9, 1>> flat(contribution.data());
+                terms.col(column) += w * flat;
+                terms.col(13 + column) += (w * shift) * flat;
+            };
+            add(0, tau * v * v.transpose());
+            for (int c = 0; c < 3; ++c) {
+                add(1 + c, tau * tau * v * Lv.col(c).transpose());
+                for (int d = 0; d < 3; ++d) {
+                    add(4 + 3 * c + d, -tau * tau * tau * Lv.col(c) * Lv.col(d).transpose());
+                }
             }
-            */
         }
     }
+    if (progress) progress->finish();
 
-    
-    return {sigma * norm, alpha * norm};
-}
\ No newline at end of file
+    Distributed::sumAll(terms);
+
+    auto tensor = [&](Eigen::Index column) { return Eigen::Map<const Eigen::Matrix3d>(terms.col(column).data()); };
+    for (int offset : {0, 13}) {
+        FieldExpansion& x = offset == 0 ? result.sigma : result.alpha;
+        x.zero = tensor(offset);
+        for (int c = 0; c < 3; ++c) x.linear[c] = tensor(offset + 1 + c);
+        for (int cd = 0; cd < 9; ++cd) x.quadratic[cd] = tensor(offset + 4 + cd);
+    }
+    return result;
+}
+
+
+Eigen::Matrix3d FieldExpansion::at(const Eigen::Vector3d& B) const {
+    Eigen::Matrix3d x = zero;
+    for (int c = 0; c < 3; ++c) {
+        x += B(c) * linear[c];
+        for (int d = 0; d < 3; ++d) x += B(c) * B(d) * quadratic[3 * c + d];
+    }
+    return x;
+}
+
+Eigen::Matrix3d MagnetoTransport::resistivity(const Eigen::Vector3d& B) const {
+    const Eigen::Matrix3d sigmaB = sigma.at(B);
+    Eigen::Matrix3d rho = Eigen::Matrix3d::Zero();
+    if (dimension == 2) {
+        rho.topLeftCorner<2, 2>() = sigmaB.topLeftCorner<2, 2>().inverse();
+    } else {
+        rho = sigmaB.inverse();
+    }
+    return rho;
+}
+
+double MagnetoTransport::hallCoefficient(double Bz) const {
+    if (Bz != 0.0) return resistivity(Eigen::Vector3d(0.0, 0.0, Bz))(1, 0) / Bz;
+
+    // dρ/dB = -ρ0 (dσ/dB) ρ0 at B = 0
+    const Eigen::Matrix3d rho0 = resistivity(Eigen::Vector3d::Zero());
+    return -(rho0 * sigma.linear[2] * rho0)(1, 0);
+}
+
+double MagnetoTransport::magnetoresistance(const Eigen::Vector3d& B, int direction) const {
+    const double rho0 = resistivity(Eigen::Vector3d::Zero())(direction, direction);
+    return (resistivity(B)(direction, direction) - rho0) / rho0;
+}
+
+
+std::tuple<Eigen::Matrix3d, Eigen::Matrix3d>
+BoltzmannSolver::computeFermiSurfaceTransport(const FermiSurfaceGrid& grid, double Ef, double T,
+                                              double dE) const {
+    double kT = T;
+    if (temperature_in_kelvin) {
+        const double kB = 8.617333262e-5; // eV/K
+        kT = kB * T / energy_scale;
+    }
+
+    const FermiSurface surface = grid.contours(Ef);
+    const Eigen::Matrix3d sigma = tau * surface.velocityIntegral() / surface.cellArea;
+
+    // Mott: ∫ (-∂f/∂E) (E-Ef) Σ(E) dE = (π²/3) (k_B T)² Σ'(Ef) + O(T⁴)
+    const Eigen::Matrix3d upper = grid.contours(Ef + dE).velocityIntegral();
+    const Eigen::Matrix3d lower = grid.contours(Ef - dE).velocityIntegral();
+    const Eigen::Matrix3d dsigma = tau * (upper - lower) / (2.0 * dE * surface.cellArea);
+    const Eigen::Matrix3d alpha = (M_PI * M_PI / 3.0) * kT * kT / T * dsigma;
+
+    return {sigma, alpha};
+}
+
+std::tuple<Eigen::Matrix3d, Eigen::Matrix3d>
+BoltzmannSolver::computeFermiSurfaceTransport(double Ef, double T, size_t n, double dE) const {
+    const FermiSurfaceGrid grid(H, n);
+    return computeFermiSurfaceTransport(grid, Ef, T, dE);
+}
+
+
+std::tuple<Eigen::Matrix3d, Eigen::Matrix3d>
+BoltzmannSolver::computeTransportTensors(const BandInterpolator& bands, const Mesh& dense,
+                                         double Ef, double T) const {
+    Eigen::Matrix3d sigma = Eigen::Matrix3d::Zero();
+    Eigen::Matrix3d alpha = Eigen::Matrix3d::Zero();
+    const std::vector<double>& weights = dense.weights();
+
+    const auto& kpoints = dense.getKPoints();
+    const auto [k_begin, k_end] = Distributed::localRange(kpoints.size());
+
+    if (progress) progress->start(k_end - k_begin);
+    if (bands.supportsGrid(dense)) {
+        // Whole Monkhorst–Pack block at once through the separable transforms
+        Eigen::MatrixXd energies;
+        std::array<Eigen::MatrixXd, 3> velocities;
+        bands.evaluateGrid(dense, k_begin, k_end, energies, velocities);
+        for (size_t ik = k_begin; ik < k_end; ++ik) {
+            if (progress) progress->add();
+            const Eigen::Index row = static_cast<Eigen::Index>(ik - k_begin);
+            for (Eigen::Index band = 0; band < energies.cols(); ++band) {
+                const Eigen::Vector3d v(velocities[0](row, band), velocities[1](row, band), velocities[2](row, band));
+                accumulateState(energies(row, band), Ef, T, v, weights[ik], sigma, alpha);
+            }
+        }
+    } else {
+        for (size_t ik = k_begin; ik < k_end; ++ik) {
+            if (progress) progress->add();
+            bands.evaluate(kpoints[ik], interp_ws, interp_energies, interp_velocities);
+
+            for (int band = 0; band < interp_energies.size(); ++band) {
+                accumulateState(interp_energies(band), Ef, T, interp_velocities.col(band), weights[ik], sigma, alpha);
+            }
+        }
+    }
+    if (progress) progress->finish();
+
+    Distributed::sumAll(sigma);
+    Distributed::sumAll(alpha);
+
+    return {sigma, alpha};
+}
+
+
+TransportDistribution
+BoltzmannSolver::computeTransportDistribution(double Emin, double Emax, size_t nE,
+                                              const Eigen::Vector3d& Efield,
+                                              const Eigen::Vector3d& Bfield) const {
+    if (nE < 2 || !(Emax > Emin)) {
+        throw std::invalid_argument("computeTransportDistribution: need nE >= 2 and Emax > Emin");
+    }
+    if (mesh.dimension() == 2) return computeTransportDistributionImpl<2>(Emin, Emax, nE, Efield, Bfield);
+    return computeTransportDistributionImpl<3>(Emin, Emax, nE, Efield, Bfield);
+}
+
+
+template <int Dim>
+TransportDistribution
+BoltzmannSolver::computeTransportDistributionImpl(double Emin, double Emax, size_t nE,
+                                                  const Eigen::Vector3d& Efield,
+                                                  const Eigen::Vector3d& Bfield) const {
+
+    const double dE = (Emax - Emin) / static_cast<double>(nE - 1);
+    const std::vector<double>& weights = mesh.weights();
+    const Eigen::Vector3d noGradT = Eigen::Vector3d::Zero();
+
+    // Column e holds the 9 entries of Σ(E_e); one buffer keeps the MPI reduction to a single call
+    Eigen::MatrixXd histogram = Eigen::MatrixXd::Zero(9, static_cast<Eigen::Index>(nE));
+
+    const auto& kpoints = mesh.getKPoints();
+    const auto [k_begin, k_end] = Distributed::localRange(kpoints.size());
+
+    if (progress) progress->start(k_end - k_begin);
+    for (size_t ik = k_begin; ik < k_end; ++ik) {
+        if (progress) progress->add();
+        const auto& k = kpoints[ik];
+        bandGeometryImpl<Dim>(k);
+        const Eigen::VectorXd& evals = eig_ws.evals;
+
+        for (int band = 0; band < evals.size(); ++band) {
+            const double energy = evals(band);
+            const double x = (energy - Emin) / dE;
+            if (x < 0.0 || x > static_cast<double>(nE - 1)) continue;
+
+            // Ef and T only enter the ∇T term, which is zero here
+            const Eigen::Vector3d omega(0, 0, geom_omega(band));
+            VelocityResult vres = fieldVelocity(energy, 0.0, 1.0, geom_velocities.col(band), omega, noGradT, Efield, Bfield);
+            const Eigen::Vector3d& v = vres.velocity;
+            const Eigen::Matrix3d weighted = tau * weights[ik] * vres.phaseSpaceFactor * (v * v.transpose());
+
+            // Linear (tent) deposition onto the two neighbouring grid points
+            const Eigen::Index lower = std::min(static_cast<Eigen::Index>(x), static_cast<Eigen::Index>(nE - 2));
+            const double frac = x - static_cast<double>(lower);
+            const Eigen::Map<const Eigen::Matrix<double, 9, 1>> flat(weighted.data());
+            histogram.col(lower) += (1.0 - frac) * flat;
+            histogram.col(lower + 1) += frac * flat;
+        }
+    }
+    if (progress) progress->finish();
+
+    Distributed::sumAll(histogram);
+
+    TransportDistribution dist;
+    dist.dE = dE;
+    dist.temperature_in_kelvin = temperature_in_kelvin;
+    dist.energy_scale = energy_scale;
+    dist.energies.resize(nE);
+    dist.sigma.resize(nE);
+    for (size_t e = 0; e < nE; ++e) {
+        dist.energies[e] = Emin + static_cast<double>(e) * dE;
+        dist.sigma[e] = Eigen::Map<const Eigen::Matrix3d>(histogram.col(static_cast<Eigen::Index>(e)).data()) / dE;
+    }
+    return dist;
+}
+
+
+/// @details L_n = ∫ Σ(E) (-∂f/∂E) (E-Ef)^n dE on the grid; σ = L0, α = L1 / T and
+/// κ = (L2 - L1 L0⁺ L1) / T, using the pseudo-inverse so 2D (zero zz) tensors are handled.
+/// Grid points where -∂f/∂E is negligible are skipped.
+TransportCoefficients TransportDistribution::coefficients(double Ef, double T) const {
+    Eigen::Matrix3d L0 = Eigen::Matrix3d::Zero();
+    Eigen::Matrix3d L1 = Eigen::Matrix3d::Zero();
+    Eigen::Matrix3d L2 = Eigen::Matrix3d::Zero();
+
+    const double kT = temperature_in_kelvin ? 8.617333262e-5 * T / energy_scale : T;
+
+    for (size_t e = 0; e < energies.size(); ++e) {
+        const double shift = energies[e] - Ef;
+        if (std::abs(shift) > 40.0 * kT) continue; // -∂f/∂E < 1e-17 / kT
+
+        const double weight = -fermi_derivative(energies[e], Ef, T, temperature_in_kelvin, energy_scale) * dE;
+        L0 += weight * sigma[e];
+        L1 += (weight * shift) * sigma[e];
+        L2 += (weight * shift * shift) * sigma[e];
+    }
+
+    TransportCoefficients result;
+    result.sigma = L0;
+    result.alpha = L1 / T;
+    result.kappa = (L2 - L1 * L0.completeOrthogonalDecomposition().pseudoInverse() * L1) / T;
+    return result;
+}
@@ -0,0 +1,169 @@
+#include "convergence.hpp"
+#include "kubo.hpp"
+#include "boltzmann.hpp"
+#include "dos.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+
+/// @file convergence.cpp
+/// @brief Nested-mesh refinement loop and solver wrappers.
+
+MeshConvergence::MeshConvergence(const Eigen::Matrix3d& basis, int dimension,
+                                 const ConvergenceOptions& options)
+    : basis(basis), dimension(dimension), options(options) {
+    if (dimension != 2 && dimension != 3) {
+        throw std::invalid_argument("MeshConvergence: dimension must be 2 or 3");
+    }
+    if (options.initialPoints < 2 || options.maxLevels < 1) {
+        throw std::invalid_argument("MeshConvergence: need initialPoints >= 2 and maxLevels >= 1");
+    }
+}
+
+Mesh MeshConvergence::refinementPoints(size_t n, bool first) const {
+    const size_t n3 = dimension == 3 ? n : 1;
+    std::vector<Eigen::Vector3d> kpoints;
+    kpoints.reserve(n * n * n3);
+
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            for (size_t l = 0; l < n3; ++l) {
+                // Points with all-even indices already belong to the n/2 mesh
+                const bool coarse = i % 2 == 0 && j % 2 == 0 && (dimension == 2 || l % 2 == 0);
+                if (!first && coarse) continue;
+                const Eigen::Vector3d fractional(double(i) / n, double(j) / n, double(l) / n3);
+                kpoints.emplace_back(basis * fractional);
+            }
+        }
+    }
+    std::vector<double> weights(kpoints.size(), 1.0 / static_cast<double>(kpoints.size()));
+    return Mesh(std::move(kpoints), std::move(weights), dimension);
+}
+
+ConvergenceResult MeshConvergence::run(const Evaluator& evaluate) const {
+    ConvergenceResult result;
+    const double coarse_fraction = std::pow(0.5, dimension);   // share of the n/2 points in the n mesh
+
+    // Largest deviation over the selected components
+    auto selectedMax = [&](const Eigen::VectorXd& x) {
+        if (options.components.empty()) return x.size() > 0 ? x.cwiseAbs().maxCoeff() : 0.0;
+        double m = 0.0;
+        for (int c : options.components) {
+            if (c < 0 || c >= x.size()) throw std::out_of_range("MeshConvergence: component index out of range");
+            m = std::max(m, std::abs(x(c)));
+        }
+        return m;
+    };
+
+    size_t n = options.initialPoints;
+    for (size_t level = 0; level < options.maxLevels; ++level, n *= 2) {
+        const bool first = level == 0;
+        const Mesh points = refinementPoints(n, first);
+        const Eigen::VectorXd average = evaluate(points);
+
+        ConvergenceLevel step;
+        step.pointsPerAxis = n;
+        step.newPoints = points.size();
+        if (first) {
+            step.value = average;
+        } else {
+            const Eigen::VectorXd& previous = result.history.back().value;
+            if (average.size() != previous.size()) {
+                throw std::runtime_error("MeshConvergence: evaluator changed the result length");
+            }
+            step.value = coarse_fraction * previous + (1.0 - coarse_fraction) * average;
+        }
+
+        // Richardson: Q_n + (Q_n - Q_{n/2}) / (2^p - 1), where (Q_n - Q_{n/2}) / (2^p - 1) also
+        // estimates the error of Q_n. From the third level on, p is raised to the observed
+        // order when the differences shrink faster (e.g. exponentially for smooth periodic
+        // integrands), so fast convergence is neither over-extrapolated nor under-reported.
+        step.errorEstimate = std::numeric_limits<double>::infinity();
+        step.extrapolated = step.value;
+        if (!first) {
+            const ConvergenceLevel& prev = result.history.back();
+            const double change = selectedMax(step.value - prev.value);
+            double order = options.order;
+            if (result.history.size() >= 2) {
+                const double previous_change = selectedMax(prev.value - result.history[result.history.size() - 2].value);
+                if (change > 0.0 && previous_change > change) {
+                    order = std::max(order, std::log2(previous_change / change));
+                }
+            }
+            const double factor = std::pow(2.0, order) - 1.0;
+            step.extrapolated = step.value + (step.value - prev.value) / factor;
+            step.errorEstimate = change / factor;
+        }
+
+        result.totalPoints += step.newPoints;
+        result.history.push_back(step);
+
+        const Eigen::VectorXd& reported = options.extrapolate ? step.extrapolated : step.value;
+        const double scale = options.relative ? std::max(selectedMax(reported), 1e-300) : 1.0;
+        result.value = reported;
+        result.finestMesh = step.value;
+        result.errorEstimate = step.errorEstimate;
+        result.pointsPerAxis = n;
+        if (step.errorEstimate <= options.tolerance * scale) {
+            result.converged = true;
+            break;
+        }
+    }
+    return result;
+}
+
+
+Eigen::VectorXd flattenTensors(std::initializer_list<Eigen::Matrix3d> tensors) {
+    Eigen::VectorXd flat(9 * static_cast<Eigen::Index>(tensors.size()));
+    Eigen::Index offset = 0;
+    for (const auto& t : tensors) {
+        flat.segment<9>(offset) = Eigen::Map<const Eigen::Matrix<double, 9, 1>>(t.data());
+        offset += 9;
+    }
+    return flat;
+}
+
+ConvergenceResult convergeKubo(const Hamiltonian& H, double eta, double Ef, double T, int dimension,
+                               const ConvergenceOptions& options) {
+    MeshConvergence driver(H.reciprocalBasis(), dimension, options);
+    return driver.run([&](const Mesh& mesh) {
+        KuboSolver kubo(H, mesh, eta);
+        auto [sigma, alpha, kappa] = kubo.computeTransportTensors(Ef, T);
+        return flattenTensors({sigma, alpha});
+    });
+}
+
+ConvergenceResult convergeBoltzmann(const Hamiltonian& H, double tau, double Ef, double T,
+                                    const Eigen::Vector3d& gradT, const Eigen::Vector3d& Efield,
+                                    const Eigen::Vector3d& Bfield, int dimension,
+                                    const ConvergenceOptions& options) {
+    MeshConvergence driver(H.reciprocalBasis(), dimension, options);
+    return driver.run([&](const Mesh& mesh) {
+        BoltzmannSolver bolt(H, mesh, tau);
+        auto [sigma, alpha] = bolt.computeTransportTensors(Ef, T, gradT, Efield, Bfield);
+        return flattenTensors({sigma, alpha});
+    });
+}
+
+ConvergenceResult convergeDOS(const Hamiltonian& H, double Emin, double Emax, int nBins, double sigma,
+                              int dimension, const ConvergenceOptions& options) {
+    MeshConvergence driver(H.reciprocalBasis(), dimension, options);
+    return driver.run([&](const Mesh& mesh) {
+        DOS dos(H, mesh);
+        const std::vector<double> values = dos.computeDOS(Emin, Emax, nBins, sigma);
+        return Eigen::VectorXd(Eigen::Map<const Eigen::VectorXd>(values.data(), nBins));
+    });
+}
+
+std::ostream& operator<<(std::ostream& os, const ConvergenceResult& result) {
+    os << "# n  new points  error estimate\n";
+    for (const auto& level : result.history) {
+        os << level.pointsPerAxis << "  " << level.newPoints << "  " << level.errorEstimate << "\n";
+    }
+    os << (result.converged ? "Converged" : "NOT converged") << " on " << result.pointsPerAxis
+       << " points per axis (" << result.totalPoints << " k-points evaluated), error estimate "
+       << result.errorEstimate << "\n";
+    return os;
+}
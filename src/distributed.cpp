@@ -0,0 +1,85 @@
+#include "distributed.hpp"
+#include <algorithm>
+
+#ifdef QT_USE_MPI
+#include <mpi.h>
+#endif
+
+/// @file distributed.cpp
+/// @brief MPI helpers used by the solvers to split the k-point sum across ranks.
+/// @details All functions degrade to a single process when MPI is not compiled in
+/// or has not been initialised, so serial programs keep working unchanged.
+
+namespace Distributed {
+
+namespace {
+int serial_scopes = 0; // number of live SerialScope objects
+}
+
+SerialScope::SerialScope() { ++serial_scopes; }
+SerialScope::~SerialScope() { --serial_scopes; }
+
+bool active() {
+#ifdef QT_USE_MPI
+    if (serial_scopes > 0) return false;
+    int initialized = 0, finalized = 0;
+    MPI_Initialized(&initialized);
+    MPI_Finalized(&finalized);
+    return initialized && !finalized;
+#else
+    return false;
+#endif
+}
+
+int rank() {
+#ifdef QT_USE_MPI
+    if (active()) {
+        int r = 0;
+        MPI_Comm_rank(MPI_COMM_WORLD, &r);
+        return r;
+    }
+#endif
+    return 0;
+}
+
+int size() {
+#ifdef QT_USE_MPI
+    if (active()) {
+        int s = 1;
+        MPI_Comm_size(MPI_COMM_WORLD, &s);
+        return s;
+    }
+#endif
+    return 1;
+}
+
+std::pair<size_t, size_t> localRange(size_t n) {
+    const size_t nranks = static_cast<size_t>(size());
+    const size_t r = static_cast<size_t>(rank());
+
+    // Balanced blocks: the first (n % nranks) ranks get one extra item
+    const size_t chunk = n / nranks;
+    const size_t extra = n % nranks;
+    const size_t begin = r * chunk + std::min(r, extra);
+    const size_t end = begin + chunk + (r < extra ? 1 : 0);
+    return {begin, end};
+}
+
+void sumAll(double* data, size_t count) {
+#ifdef QT_USE_MPI
+    if (active() && size() > 1) {
+        MPI_Allreduce(MPI_IN_PLACE, data, static_cast<int>(count),
+                      MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    }
+#else
+    (void)data;
+    (void)count;
+#endif
+}
+
+void sumAll(std::complex<double>* data, size_t count) {
+    // std::complex<double> is layout-compatible with double[2]
+    sumAll(reinterpret_cast<double*>(data), 2 * count);
+}
+
+} // namespace Distributed
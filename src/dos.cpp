@@ -15,11 +15,15 @@ std::vector<double> DOS::computeDOS(double energy_min, double energy_max, int n_
         energy_grid_[i] = energy_min + (i + 0.5) * dE;
     }
 
-    // Loop over all k-points
-    for (const auto& k : mesh.getKPoints()) {
-        Eigen::VectorXd evals;
-        Eigen::MatrixXcd evecs;
-        H.eigensystem(k, evals, evecs);
+    // Loop over all k-points, reusing one eigen workspace (energies only, no eigenvectors)
+    EigenWorkspace ws;
+    const auto& kpoints = mesh.getKPoints();
+    const std::vector<double>& weights = mesh.weights();
+    if (progress) progress->start(mesh.size());
+    for (size_t ik = 0; ik < kpoints.size(); ++ik) {
+        if (progress) progress->add();
+        H.eigenvalues(kpoints[ik], ws);
+        const Eigen::VectorXd& evals = ws.evals;
 
         // For each eigenvalue, add Gaussian smeared delta peak to DOS
         for (int n = 0; n < evals.size(); ++n) {
@@ -30,14 +34,15 @@ std::vector<double> DOS::computeDOS(double energy_min, double energy_max, int n_
 
             for (int bin = start_bin; bin <= end_bin; ++bin) {
                 double x = (energy_grid_[bin] - energy) / sigma;
-                double weight = std::exp(-0.5 * x * x) / (sigma * std::sqrt(2 * M_PI));
+                double weight = weights[ik] * std::exp(-0.5 * x * x) / (sigma * std::sqrt(2 * M_PI));
                 dos[bin] += weight;
             }
         }
     }
+    if (progress) progress->finish();
 
-    // Normalize by number of k-points and bin width to get DOS per energy unit
-    double norm = 1.0 / (mesh.size() * dE);
+    // Normalize by the bin width to get DOS per energy unit (the k-point weights sum to 1)
+    double norm = 1.0 / dE;
     for (auto& val : dos) {
         val *= norm;
     }
@@ -55,14 +60,19 @@ std::vector<double> DOS::computeProjectedDOS(double E_min, double E_max, int N_b
         energy_grid_[i] = E_min + (i + 0.5) * dE;
     }
 
-    Eigen::VectorXd evals;
-    Eigen::MatrixXcd evecs;
+    EigenWorkspace ws;
+    const Eigen::VectorXd& evals = ws.evals;
+    const Eigen::MatrixXcd& evecs = ws.evecs;
 
-    for (const auto& k : mesh.getKPoints()) {
-        H.eigensystem(k, evals, evecs);
+    const auto& kpoints = mesh.getKPoints();
+    const std::vector<double>& weights = mesh.weights();
+    if (progress) progress->start(mesh.size());
+    for (size_t ik = 0; ik < kpoints.size(); ++ik) {
+        if (progress) progress->add();
+        H.eigensystem(kpoints[ik], ws);
         for (int n = 0; n < evals.size(); ++n) {
             std::complex<double> amp = evecs.col(n)(orbital_index);
-            double weight = std::norm(amp);  // |⟨i|ψ⟩|^2
+            double weight = weights[ik] * std::norm(amp);  // w_k |⟨i|ψ⟩|^2
 
             for (int i = 0; i < N_bins; ++i) {
                 double x = (energy_grid_[i] - evals[n]) / eta;
@@ -70,11 +80,7 @@ std::vector<double> DOS::computeProjectedDOS(double E_min, double E_max, int N_b
             }
         }
     }
-
-    double norm = 1.0 / static_cast<double>(mesh.size());
-    for (auto& d : pdos) {
-        d *= norm;
-    }
+    if (progress) progress->finish();
 
     return pdos;
 }
@@ -0,0 +1,245 @@
+#include "fermi_surface.hpp"
+#include "two_band.hpp"
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+/// @file fermi_surface.cpp
+/// @brief Marching squares on a periodic band-energy grid with refined edge crossings.
+
+namespace {
+
+/// @brief Scratch for velocity evaluations along the contours
+struct ContourWorkspace {
+    EigenWorkspace eig;
+    Eigen::MatrixXcd dH, H_plus, H_minus;
+    Eigen::VectorXcd product;
+};
+
+/// @brief Energy of one band at k
+double bandEnergy(const Hamiltonian& H, const Eigen::Vector3d& k, int band, ContourWorkspace& ws) {
+    H.eigenvalues(k, ws.eig);
+    return ws.eig.evals(band);
+}
+
+/// @brief In-plane band velocity v_i = <n|∂_i H|n> (analytic ∂H if available, else central differences)
+/// @details Two-band models return their closed-form velocities without an eigensystem.
+Eigen::Vector3d bandVelocity(const Hamiltonian& H, const Eigen::Vector3d& k, int band, ContourWorkspace& ws) {
+    if (const auto* two_band = dynamic_cast<const TwoBandModel*>(&H)) {
+        TwoBandGeometry geometry;
+        two_band->bandGeometry(k, geometry);
+        Eigen::Vector3d v = geometry.velocities.col(band);
+        v(2) = 0.0;
+        return v;
+    }
+
+    H.eigensystem(k, ws.eig);
+    const auto u = ws.eig.evecs.col(band);
+
+    Eigen::Vector3d v = Eigen::Vector3d::Zero();
+    for (int i = 0; i < 2; ++i) {
+        if (!H.dHdk(k, i, ws.dH)) {
+            Eigen::Vector3d dk = Eigen::Vector3d::Zero();
+            dk(i) = 1e-5;
+            H.Hk(k + dk, ws.H_plus);
+            H.Hk(k - dk, ws.H_minus);
+            ws.dH = (ws.H_plus - ws.H_minus) / (2.0 * dk(i));
+        }
+        ws.product.noalias() = ws.dH * u;
+        v(i) = u.dot(ws.product).real();
+    }
+    return v;
+}
+
+/// @brief Crossing of ε_n = E on the straight edge ka → kb, refined by Illinois regula falsi
+/// @param fa ε_n(ka) - E, @param fb ε_n(kb) - E (opposite signs)
+/// @return Edge parameter t ∈ [0, 1] of the crossing
+double refineCrossing(const Hamiltonian& H, const Eigen::Vector3d& ka, const Eigen::Vector3d& kb,
+                      int band, double E, double fa, double fb, double tolerance, ContourWorkspace& ws) {
+    double ta = 0.0, tb = 1.0;
+    double t = 0.5;
+    int side = 0;
+    for (int iter = 0; iter < 60; ++iter) {
+        t = (fa * tb - fb * ta) / (fa - fb);
+        const double f = bandEnergy(H, ka + t * (kb - ka), band, ws) - E;
+        if (std::abs(f) <= tolerance || tb - ta < 1e-14) break;
+
+        if ((f > 0.0) == (fb > 0.0)) {
+            tb = t;
+            fb = f;
+            if (side == -1) fa *= 0.5;
+            side = -1;
+        } else {
+            ta = t;
+            fa = f;
+            if (side == 1) fb *= 0.5;
+            side = 1;
+        }
+    }
+    return t;
+}
+
+/// @brief Cached crossing on one grid edge
+struct EdgeCrossing {
+    bool computed = false;
+    double t = 0.0;
+    Eigen::Vector3d v = Eigen::Vector3d::Zero();
+};
+
+} // namespace
+
+
+double FermiSurface::length(int band) const {
+    double total = 0.0;
+    for (const auto& s : segments) {
+        if (band < 0 || s.band == band) total += (s.b.k - s.a.k).norm();
+    }
+    return total;
+}
+
+Eigen::Matrix3d FermiSurface::velocityIntegral() const {
+    Eigen::Matrix3d integral = Eigen::Matrix3d::Zero();
+    auto integrand = [](const Eigen::Vector3d& v) -> Eigen::Matrix3d {
+        const double speed = v.norm();
+        if (speed < 1e-12) return Eigen::Matrix3d::Zero(); // band extremum on the contour
+        return v * v.transpose() / speed;
+    };
+    for (const auto& s : segments) {
+        integral += 0.5 * (integrand(s.a.v) + integrand(s.b.v)) * (s.b.k - s.a.k).norm();
+    }
+    return integral;
+}
+
+
+FermiSurfaceGrid::FermiSurfaceGrid(const Hamiltonian& H, size_t n1, size_t n2)
+    : H(H), n1_(n1), n2_(n2 == 0 ? n1 : n2) {
+    if (n1_ < 2 || n2_ < 2) throw std::invalid_argument("FermiSurfaceGrid: need at least 2 x 2 grid points");
+
+    const Eigen::Matrix3d basis = H.reciprocalBasis();
+    b1_ = basis.col(0);
+    b2_ = basis.col(1);
+    if (std::abs(b1_(2)) > 1e-12 || std::abs(b2_(2)) > 1e-12) {
+        throw std::invalid_argument("FermiSurfaceGrid: b1 and b2 must lie in the kx-ky plane");
+    }
+    cellArea_ = std::abs(b1_(0) * b2_(1) - b1_(1) * b2_(0));
+
+    EigenWorkspace probe;
+    H.eigenvalues(cartesian(0.0, 0.0), probe);
+    energies_.resize(probe.evals.size(), static_cast<Eigen::Index>(n1_ * n2_));
+
+    #pragma omp parallel
+    {
+        EigenWorkspace ws;
+        #pragma omp for schedule(static)
+        for (long p = 0; p < static_cast<long>(n1_ * n2_); ++p) {
+            const double f1 = static_cast<double>(p / static_cast<long>(n2_)) / n1_;
+            const double f2 = static_cast<double>(p % static_cast<long>(n2_)) / n2_;
+            H.eigenvalues(cartesian(f1, f2), ws);
+            energies_.col(p) = ws.evals;
+        }
+    }
+}
+
+Eigen::Vector3d FermiSurfaceGrid::cartesian(double f1, double f2) const {
+    return f1 * b1_ + f2 * b2_;
+}
+
+double FermiSurfaceGrid::energy(int band, long i, long j) const {
+    const long n1 = static_cast<long>(n1_), n2 = static_cast<long>(n2_);
+    i = ((i % n1) + n1) % n1;
+    j = ((j % n2) + n2) % n2;
+    return energies_(band, i * n2 + j);
+}
+
+FermiSurface FermiSurfaceGrid::contours(double E, double tolerance) const {
+    FermiSurface surface;
+    surface.energy = E;
+    surface.cellArea = cellArea_;
+
+    const long n1 = static_cast<long>(n1_), n2 = static_cast<long>(n2_);
+    ContourWorkspace ws;
+    std::vector<EdgeCrossing> horizontal, vertical; // edges (i,j)→(i+1,j) and (i,j)→(i,j+1)
+
+    for (int band = 0; band < numBands(); ++band) {
+        // Skip bands entirely above or below E
+        if (energies_.row(band).minCoeff() > E || energies_.row(band).maxCoeff() <= E) continue;
+
+        horizontal.assign(n1_ * n2_, EdgeCrossing());
+        vertical.assign(n1_ * n2_, EdgeCrossing());
+
+        // Crossing on the edge from grid point (i, j) along axis 0 (b1) or 1 (b2)
+        auto crossing = [&](long i, long j, int axis) -> const EdgeCrossing& {
+            const long ii = ((i % n1) + n1) % n1, jj = ((j % n2) + n2) % n2;
+            EdgeCrossing& edge = (axis == 0 ? horizontal : vertical)[ii * n2 + jj];
+            if (!edge.computed) {
+                const Eigen::Vector3d ka = cartesian(double(ii) / n1, double(jj) / n2);
+                const Eigen::Vector3d kb = axis == 0 ? cartesian(double(ii + 1) / n1, double(jj) / n2)
+                                                     : cartesian(double(ii) / n1, double(jj + 1) / n2);
+                const double fa = energy(band, ii, jj) - E;
+                const double fb = (axis == 0 ? energy(band, ii + 1, jj) : energy(band, ii, jj + 1)) - E;
+                edge.t = refineCrossing(H, ka, kb, band, E, fa, fb, tolerance, ws);
+                edge.v = bandVelocity(H, ka + edge.t * (kb - ka), band, ws);
+                edge.computed = true;
+            }
+            return edge;
+        };
+
+        for (long i = 0; i < n1; ++i) {
+            for (long j = 0; j < n2; ++j) {
+                // Corners counter-clockwise: (i,j), (i+1,j), (i+1,j+1), (i,j+1)
+                const std::array<double, 4> f = {energy(band, i, j) - E, energy(band, i + 1, j) - E,
+                                                 energy(band, i + 1, j + 1) - E, energy(band, i, j + 1) - E};
+                const std::array<bool, 4> above = {f[0] > 0.0, f[1] > 0.0, f[2] > 0.0, f[3] > 0.0};
+                if (above[0] == above[1] && above[1] == above[2] && above[2] == above[3]) continue;
+
+                // Edges 0..3 (bottom, right, top, left) and their crossing points in cell coordinates
+                std::array<bool, 4> cut;
+                std::array<FermiPoint, 4> point;
+                for (int e = 0; e < 4; ++e) {
+                    cut[e] = above[e] != above[(e + 1) % 4];
+                    if (!cut[e]) continue;
+                    double f1 = i, f2 = j;
+                    if (e == 0) {
+                        const EdgeCrossing& c = crossing(i, j, 0);
+                        f1 += c.t;
+                        point[e].v = c.v;
+                    } else if (e == 1) {
+                        const EdgeCrossing& c = crossing(i + 1, j, 1);
+                        f1 += 1.0;
+                        f2 += c.t;
+                        point[e].v = c.v;
+                    } else if (e == 2) {
+                        const EdgeCrossing& c = crossing(i, j + 1, 0);
+                        f1 += c.t;
+                        f2 += 1.0;
+                        point[e].v = c.v;
+                    } else {
+                        const EdgeCrossing& c = crossing(i, j, 1);
+                        f2 += c.t;
+                        point[e].v = c.v;
+                    }
+                    point[e].k = cartesian(f1 / n1, f2 / n2);
+                }
+
+                const int ncut = cut[0] + cut[1] + cut[2] + cut[3];
+                if (ncut == 2) {
+                    int first = -1, second = -1;
+                    for (int e = 0; e < 4; ++e) {
+                        if (!cut[e]) continue;
+                        (first < 0 ? first : second) = e;
+                    }
+                    surface.segments.push_back({band, point[first], point[second]});
+                } else {
+                    // Saddle cell: corners on the other side than the cell centre are cut off.
+                    // Corner c touches edges c - 1 and c.
+                    const bool centre_above = (f[0] + f[1] + f[2] + f[3]) > 0.0;
+                    for (int c = 0; c < 4; ++c) {
+                        if (above[c] == centre_above) continue;
+                        surface.segments.push_back({band, point[(c + 3) % 4], point[c]});
+                    }
+                }
+            }
+        }
+    }
+    return surface;
+}
@@ -1,4 +1,6 @@
 #include "hamiltonian.hpp"
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 /// @brief  Hamiltonian class implementation
@@ -25,4 +27,449 @@ void Hamiltonian::eigensystem(const Vec& k, Eigen::VectorXd& evals, Eigen::Matri
     
     evals = solver.eigenvalues();
     evecs = solver.eigenvectors();
-}
\ No newline at end of file
+}
+
+
+/// @brief Allocation-free eigensystem into a caller-owned workspace
+/// @param k Wavevector
+/// @param ws Workspace receiving H(k), eigenvalues and eigenvectors
+void Hamiltonian::eigensystem(const Vec& k, EigenWorkspace& ws) const {
+    Hk(k, ws.Hk);
+
+    if (ws.solve() != Eigen::Success) {
+        throw std::runtime_error("Eigensystem computation failed");
+    }
+}
+
+
+/// @brief Eigenvalues only, via SelfAdjointEigenSolver with EigenvaluesOnly
+/// @param k Wavevector
+/// @param evals Eigenvalues in ascending order
+void Hamiltonian::eigenvalues(const Vec& k, Eigen::VectorXd& evals) const {
+    Eigen::SelfAdjointEigenSolver<Mat> solver(Hk(k), Eigen::EigenvaluesOnly);
+
+    if (solver.info() != Eigen::Success) {
+        throw std::runtime_error("Eigenvalue computation failed");
+    }
+
+    evals = solver.eigenvalues();
+}
+
+
+/// @brief Allocation-free eigenvalues into a caller-owned workspace
+/// @param k Wavevector
+/// @param ws Workspace receiving H(k) and the eigenvalues
+void Hamiltonian::eigenvalues(const Vec& k, EigenWorkspace& ws) const {
+    Hk(k, ws.Hk);
+
+    if (ws.solveEigenvalues() != Eigen::Success) {
+        throw std::runtime_error("Eigenvalue computation failed");
+    }
+}
+
+
+void EigenWorkspace::resize(Eigen::Index n) {
+    Hk.resize(n, n);
+    evals.resize(n);
+    evecs.resize(n, n);
+    reflectors_.resize(n, n);
+    subdiag_.resize(n > 1 ? n - 1 : 0);
+    hcoeffs_.resize(n > 1 ? n - 1 : 0);
+    householder_work_.resize(n);
+}
+
+
+#if QT_EIGEN_TRIDIAGONAL_INTERNALS
+double EigenWorkspace::tridiagonalize() {
+    // Work on the lower triangle, scaled to avoid over/underflow (as SelfAdjointEigenSolver does)
+    reflectors_ = Hk.triangularView<Eigen::Lower>();
+    double scale = reflectors_.cwiseAbs().maxCoeff();
+    if (scale == 0.0) scale = 1.0;
+    reflectors_.triangularView<Eigen::Lower>() /= scale;
+
+    // Householder tridiagonalization: reflectors are stored below the subdiagonal
+    Eigen::internal::tridiagonalization_inplace(reflectors_, hcoeffs_);
+    return scale;
+}
+
+
+Eigen::ComputationInfo EigenWorkspace::tridiagonalEigenvalues() {
+    all_evals_ = reflectors_.diagonal().real();
+    subdiag_ = reflectors_.diagonal<-1>().real();
+    return Eigen::internal::computeFromTridiagonal_impl(
+        all_evals_, subdiag_, Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd>::m_maxIterations, false, evecs);
+}
+#endif
+
+
+Eigen::ComputationInfo EigenWorkspace::solve() {
+    excludedBelow = -std::numeric_limits<double>::infinity();
+    excludedAbove = std::numeric_limits<double>::infinity();
+#if !QT_EIGEN_TRIDIAGONAL_INTERNALS
+    fallback_.compute(Hk);
+    evals = fallback_.eigenvalues();
+    evecs = fallback_.eigenvectors();
+    return fallback_.info();
+#else
+    const Eigen::Index n = Hk.rows();
+    if (evecs.rows() != n || evecs.cols() != n || householder_work_.size() != n) resize(n);
+
+    const double scale = tridiagonalize();
+    evals = reflectors_.diagonal().real();
+    subdiag_ = reflectors_.diagonal<-1>().real();
+
+    // Accumulate Q = H_0 ... H_{n-2} into evecs, one reflector at a time
+    evecs.setIdentity();
+    for (Eigen::Index i = n - 2; i >= 0; --i) {
+        const Eigen::Index corner = n - i - 1;
+        evecs.bottomRightCorner(corner, corner).applyHouseholderOnTheLeft(
+            reflectors_.col(i).tail(corner - 1), std::conj(hcoeffs_(i)), householder_work_.data());
+    }
+
+    // Implicit symmetric QR on the tridiagonal matrix, rotating Q into the eigenvectors
+    const Eigen::ComputationInfo info = Eigen::internal::computeFromTridiagonal_impl(
+        evals, subdiag_, Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd>::m_maxIterations, true, evecs);
+
+    evals *= scale;
+    return info;
+#endif
+}
+
+
+Eigen::ComputationInfo EigenWorkspace::solveEigenvalues() {
+    const Eigen::Index n = Hk.rows();
+    excludedBelow = -std::numeric_limits<double>::infinity();
+    excludedAbove = std::numeric_limits<double>::infinity();
+    if (evals.size() != n) evals.resize(n);
+
+    // Closed forms from the lower triangle, as tridiagonalize reads it
+    auto pair = [&](Eigen::Index i, double& lower, double& upper) {
+        const double mean = 0.5 * (Hk(i, i).real() + Hk(i + 1, i + 1).real());
+        const double radius = std::hypot(0.5 * (Hk(i, i).real() - Hk(i + 1, i + 1).real()), std::abs(Hk(i + 1, i)));
+        lower = mean - radius;
+        upper = mean + radius;
+    };
+    if (n == 2) {
+        pair(0, evals(0), evals(1));
+        return Eigen::Success;
+    }
+    if (n == 4 && Hk.block<2, 2>(2, 0).isZero(0.0)) {
+        // Two decoupled 2 x 2 blocks (e.g. spin-conserving Kane-Mele)
+        pair(0, evals(0), evals(1));
+        pair(2, evals(2), evals(3));
+        std::sort(evals.data(), evals.data() + 4);
+        return Eigen::Success;
+    }
+#if !QT_EIGEN_TRIDIAGONAL_INTERNALS
+    fallback_.compute(Hk, Eigen::EigenvaluesOnly);
+    evals = fallback_.eigenvalues();
+    return fallback_.info();
+#else
+    if (householder_work_.size() != n) resize(n);
+
+    const double scale = tridiagonalize();
+    const Eigen::ComputationInfo info = tridiagonalEigenvalues();
+    evals = all_evals_ * scale;
+    return info;
+#endif
+}
+
+
+Eigen::Index EigenWorkspace::windowStart(Eigen::Index nbands, double target, double scale) {
+    const Eigen::Index n = all_evals_.size();
+    Eigen::Index lo = std::lower_bound(all_evals_.data(), all_evals_.data() + n, target) - all_evals_.data();
+    Eigen::Index hi = lo;
+    while (hi - lo < nbands) {
+        if (lo == 0) { ++hi; continue; }
+        if (hi == n) { --lo; continue; }
+        if (target - all_evals_(lo - 1) <= all_evals_(hi) - target) --lo; else ++hi;
+    }
+    excludedBelow = (lo > 0) ? all_evals_(lo - 1) * scale : -std::numeric_limits<double>::infinity();
+    excludedAbove = (hi < n) ? all_evals_(hi) * scale : std::numeric_limits<double>::infinity();
+    return lo;
+}
+
+
+Eigen::ComputationInfo EigenWorkspace::solveWindowEigenvalues(Eigen::Index nbands, double center) {
+    const Eigen::Index n = Hk.rows();
+    windowIterations = 0;
+    if (nbands >= n) return solveEigenvalues();
+    if (nbands <= 0) throw std::invalid_argument("solveWindowEigenvalues: nbands must be positive");
+    if (n >= iterativeWindowMinOrbitals && 48 * nbands <= n && solveWindowIterative(nbands, center)) {
+        return Eigen::Success;
+    }
+    return solveWindowDirect(nbands, center, false);
+}
+
+
+Eigen::ComputationInfo EigenWorkspace::solveWindow(Eigen::Index nbands, double center) {
+    const Eigen::Index n = Hk.rows();
+    windowIterations = 0;
+    if (nbands >= n) return solve();
+    if (nbands <= 0) throw std::invalid_argument("solveWindow: nbands must be positive");
+    if (n >= iterativeWindowMinOrbitals && 48 * nbands <= n && solveWindowIterative(nbands, center)) {
+        evecs.resize(n, nbands);
+        evecs = window_vectors_;
+        return Eigen::Success;
+    }
+    return solveWindowDirect(nbands, center, true);
+}
+
+
+Eigen::Index EigenWorkspace::orthonormalizeKrylov(Eigen::Index first, Eigen::Index last) {
+    Eigen::Index kept = first;
+    for (Eigen::Index j = first; j < last; ++j) {
+        if (j != kept) krylov_.col(kept) = krylov_.col(j);
+        auto v = krylov_.col(kept);
+        const double original = v.norm();
+        if (!(original > 0.0)) continue;
+        for (int pass = 0; pass < 2 && kept > 0; ++pass) {
+            auto overlap = krylov_overlap_.head(kept);
+            overlap.noalias() = krylov_.leftCols(kept).adjoint() * v;
+            v.noalias() -= krylov_.leftCols(kept) * overlap;
+        }
+        const double norm = v.norm();
+        if (norm <= 1e-10 * original) continue; // (numerically) in the span already
+        v /= norm;
+        ++kept;
+    }
+    return kept;
+}
+
+
+bool EigenWorkspace::solveWindowIterative(Eigen::Index nbands, double center) {
+    const Eigen::Index n = Hk.rows();
+    const Eigen::Index block = nbands + (nbands + 1) / 2; // window + guard vectors
+    const int depth = 5;                                  // Krylov blocks on top of the start block
+    const int max_iterations = 50;
+
+    double hnorm = Hk.cwiseAbs().rowwise().sum().maxCoeff();
+    if (hnorm == 0.0) hnorm = 1.0;
+    const double tol = 1e-12 * hnorm;
+    // Offset the shift so that an eigenvalue exactly at center does not make H - σ singular
+    const double sigma = center + 1e-9 * hnorm;
+    shifted_lu_.compute(Hk - sigma * Eigen::MatrixXcd::Identity(n, n));
+
+    // Start from the Ritz block of the previous call, with one fresh column so that a band
+    // missing from it (the window moved) can still enter
+    const bool warm = ritz_block_.rows() == n && ritz_block_.cols() == block;
+    if (!warm) ritz_block_.resize(n, block);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    for (Eigen::Index j = warm ? block - 1 : 0; j < block; ++j) {
+        for (Eigen::Index i = 0; i < n; ++i) {
+            ritz_block_(i, j) = std::complex<double>(uniform(start_generator_), uniform(start_generator_));
+        }
+    }
+
+    krylov_.resize(n, (depth + 1) * block);
+    krylov_image_.resize(n, (depth + 1) * block);
+    krylov_overlap_.resize((depth + 1) * block);
+    ritz_values_.resize(block);
+    ritz_residuals_.resize(block);
+
+    for (windowIterations = 1; windowIterations <= max_iterations; ++windowIterations) {
+        // Block Krylov space of (H - σ)⁻¹; the image of every orthonormal block is kept, so
+        // the projection V^H (H - σ)⁻¹ V costs no extra solves
+        krylov_.leftCols(block) = ritz_block_;
+        Eigen::Index start = 0, end = orthonormalizeKrylov(0, block);
+        for (int d = 0;; ++d) {
+            const Eigen::Index width = end - start;
+            krylov_image_.middleCols(start, width) = shifted_lu_.solve(krylov_.middleCols(start, width));
+            if (d == depth) break;
+            krylov_.middleCols(end, width) = krylov_image_.middleCols(start, width);
+            start = end;
+            end = orthonormalizeKrylov(end, end + width);
+            if (end == start) break; // invariant subspace
+        }
+        const Eigen::Index dim = end;
+        if (dim < block) break;
+
+        // Rayleigh-Ritz: the eigenvalues of (H - σ)⁻¹ largest in magnitude belong to the
+        // eigenvalues of H closest to σ (the solver reads the lower triangle only)
+        projected_.noalias() = krylov_.leftCols(dim).adjoint() * krylov_image_.leftCols(dim);
+        projected_solver_.compute(projected_);
+        if (projected_solver_.info() != Eigen::Success) break;
+        const Eigen::VectorXd& mu = projected_solver_.eigenvalues();
+        ritz_order_.resize(dim);
+        for (Eigen::Index j = 0; j < dim; ++j) ritz_order_[j] = j;
+        std::partial_sort(ritz_order_.begin(), ritz_order_.begin() + block, ritz_order_.end(),
+                          [&](Eigen::Index a, Eigen::Index b) { return std::abs(mu(a)) > std::abs(mu(b)); });
+        ritz_coefficients_.resize(dim, block);
+        for (Eigen::Index j = 0; j < block; ++j) {
+            ritz_coefficients_.col(j) = projected_solver_.eigenvectors().col(ritz_order_[j]);
+        }
+        ritz_block_.noalias() = krylov_.leftCols(dim) * ritz_coefficients_;
+        ritz_image_.noalias() = Hk * ritz_block_;
+
+        double residual = 0.0;
+        for (Eigen::Index j = 0; j < block; ++j) {
+            ritz_values_(j) = ritz_block_.col(j).dot(ritz_image_.col(j)).real();
+            ritz_residuals_(j) = (ritz_image_.col(j) - ritz_values_(j) * ritz_block_.col(j)).norm();
+            if (j < nbands) residual = std::max(residual, ritz_residuals_(j));
+        }
+        if (!std::isfinite(residual)) break;
+        if (residual <= tol) {
+            // Window in ascending order
+            ritz_order_.resize(nbands);
+            for (Eigen::Index j = 0; j < nbands; ++j) ritz_order_[j] = j;
+            std::sort(ritz_order_.begin(), ritz_order_.end(),
+                      [&](Eigen::Index a, Eigen::Index b) { return ritz_values_(a) < ritz_values_(b); });
+            evals.resize(nbands);
+            window_vectors_.resize(n, nbands);
+            for (Eigen::Index j = 0; j < nbands; ++j) {
+                evals(j) = ritz_values_(ritz_order_[j]);
+                window_vectors_.col(j) = ritz_block_.col(ritz_order_[j]);
+            }
+
+            // Excluded eigenvalues from the guard Ritz values, moved towards the window by
+            // their residual (each interval θ ± r holds an eigenvalue). A side without guard
+            // values lies at least as far from σ as the nearest guard interval.
+            double nearest = std::numeric_limits<double>::infinity();
+            excludedBelow = -std::numeric_limits<double>::infinity();
+            excludedAbove = std::numeric_limits<double>::infinity();
+            for (Eigen::Index j = nbands; j < block; ++j) {
+                const double theta = ritz_values_(j), r = ritz_residuals_(j);
+                nearest = std::min(nearest, std::abs(theta - sigma) - r);
+                if (theta < sigma) excludedBelow = std::max(excludedBelow, theta + r);
+                else excludedAbove = std::min(excludedAbove, theta - r);
+            }
+            if (!std::isfinite(excludedBelow)) excludedBelow = sigma - nearest;
+            if (!std::isfinite(excludedAbove)) excludedAbove = sigma + nearest;
+            return true;
+        }
+    }
+
+    // Not converged: drop the start basis and let the caller take the direct path
+    ritz_block_.resize(0, 0);
+    windowIterations = 0;
+    return false;
+}
+
+
+Eigen::ComputationInfo EigenWorkspace::solveWindowDirect(Eigen::Index nbands, double center, bool vectors) {
+    const Eigen::Index n = Hk.rows();
+#if !QT_EIGEN_TRIDIAGONAL_INTERNALS
+    // Full spectrum through the public solver, then keep the window
+    const Eigen::ComputationInfo info = vectors ? solve() : solveEigenvalues();
+    if (info != Eigen::Success) return info;
+    all_evals_ = evals;
+    const Eigen::Index lo = windowStart(nbands, center, 1.0);
+    evals = all_evals_.segment(lo, nbands);
+    if (vectors) evecs = evecs.middleCols(lo, nbands).eval();
+    return Eigen::Success;
+#else
+    if (householder_work_.size() != n) resize(n);
+
+    const double scale = tridiagonalize();
+    const double target = center / scale;
+
+    tridiag_diag_ = reflectors_.diagonal().real();
+    tridiag_sub_ = reflectors_.diagonal<-1>().real();
+
+    // 1. All eigenvalues of the tridiagonal matrix (no vectors: O(N²))
+    const Eigen::ComputationInfo info = tridiagonalEigenvalues();
+    if (info != Eigen::Success) return info;
+
+    // 2. The nbands contiguous eigenvalues closest to the target
+    const Eigen::Index lo = windowStart(nbands, target, scale);
+    if (!vectors) {
+        evals = all_evals_.segment(lo, nbands) * scale;
+        return Eigen::Success;
+    }
+
+    // 3. Tridiagonal eigenvectors by inverse iteration (LAPACK stein-style), re-orthogonalized
+    //    within clusters of close eigenvalues so degenerate (e.g. Kramers) pairs stay orthogonal
+    const double tnorm = std::max(tridiag_diag_.cwiseAbs().maxCoeff(),
+                                  n > 1 ? tridiag_sub_.cwiseAbs().maxCoeff() : 0.0) + 1e-300;
+    const double eps = std::numeric_limits<double>::epsilon();
+    const double cluster_tol = 1e-3 * tnorm;
+
+    tridiag_vectors_.resize(n, nbands);
+    lu_dl_.resize(n); lu_d_.resize(n); lu_du_.resize(n); lu_du2_.resize(n);
+    lu_pivot_.resize(n);
+    inverse_iterate_.resize(n);
+
+    Eigen::Index cluster_start = 0;
+    double previous = 0.0;
+    for (Eigen::Index j = 0; j < nbands; ++j) {
+        double lambda = all_evals_(lo + j);
+        if (j > 0) {
+            if (lambda - all_evals_(lo + j - 1) > cluster_tol) cluster_start = j;
+            // Separate (numerically) equal shifts so the iterates differ
+            if (lambda - previous < 10.0 * eps * tnorm) lambda = previous + 10.0 * eps * tnorm;
+        }
+        previous = lambda;
+
+        // Pivoted LU of T - λI (LAPACK gttrf)
+        for (Eigen::Index i = 0; i < n; ++i) lu_d_(i) = tridiag_diag_(i) - lambda;
+        for (Eigen::Index i = 0; i + 1 < n; ++i) { lu_dl_(i) = tridiag_sub_(i); lu_du_(i) = tridiag_sub_(i); }
+        lu_du2_.setZero();
+        for (Eigen::Index i = 0; i + 1 < n; ++i) {
+            if (std::abs(lu_d_(i)) >= std::abs(lu_dl_(i))) {
+                lu_pivot_(i) = 0;
+                if (lu_d_(i) != 0.0) {
+                    const double fact = lu_dl_(i) / lu_d_(i);
+                    lu_dl_(i) = fact;
+                    lu_d_(i + 1) -= fact * lu_du_(i);
+                }
+            } else {
+                lu_pivot_(i) = 1;
+                const double fact = lu_d_(i) / lu_dl_(i);
+                lu_d_(i) = lu_dl_(i);
+                lu_dl_(i) = fact;
+                const double temp = lu_du_(i);
+                lu_du_(i) = lu_d_(i + 1);
+                lu_d_(i + 1) = temp - fact * lu_d_(i + 1);
+                if (i + 2 < n) {
+                    lu_du2_(i) = lu_du_(i + 1);
+                    lu_du_(i + 1) = -fact * lu_du_(i + 1);
+                }
+            }
+        }
+        for (Eigen::Index i = 0; i < n; ++i) {
+            if (std::abs(lu_d_(i)) < eps * tnorm) lu_d_(i) = eps * tnorm; // exact eigenvalue: perturb the pivot
+        }
+
+        // Deterministic, non-degenerate start vector
+        for (Eigen::Index i = 0; i < n; ++i) inverse_iterate_(i) = 1.0 + 0.5 * std::sin(1.0 + i + 7.0 * j);
+
+        for (int iteration = 0; iteration < 3; ++iteration) {
+            // Solve (T - λI) x = b with the pivoted factors (LAPACK gttrs)
+            auto& b = inverse_iterate_;
+            for (Eigen::Index i = 0; i + 1 < n; ++i) {
+                if (lu_pivot_(i) == 0) {
+                    b(i + 1) -= lu_dl_(i) * b(i);
+                } else {
+                    const double temp = b(i);
+                    b(i) = b(i + 1);
+                    b(i + 1) = temp - lu_dl_(i) * b(i);
+                }
+            }
+            b(n - 1) /= lu_d_(n - 1);
+            if (n > 1) b(n - 2) = (b(n - 2) - lu_du_(n - 2) * b(n - 1)) / lu_d_(n - 2);
+            for (Eigen::Index i = n - 3; i >= 0; --i) {
+                b(i) = (b(i) - lu_du_(i) * b(i + 1) - lu_du2_(i) * b(i + 2)) / lu_d_(i);
+            }
+
+            // Orthogonalize against the converged vectors of the same cluster
+            for (Eigen::Index c = cluster_start; c < j; ++c) {
+                b -= tridiag_vectors_.col(c).dot(b) * tridiag_vectors_.col(c);
+            }
+            b.normalize();
+        }
+        tridiag_vectors_.col(j) = inverse_iterate_;
+    }
+
+    // 4. Back-transform only the window vectors: evecs = Q z with Q = H_0 ... H_{n-2}
+    evecs.resize(n, nbands);
+    evecs = tridiag_vectors_.cast<std::complex<double>>();
+    for (Eigen::Index i = n - 2; i >= 0; --i) {
+        const Eigen::Index corner = n - i - 1;
+        evecs.bottomRows(corner).applyHouseholderOnTheLeft(
+            reflectors_.col(i).tail(corner - 1), std::conj(hcoeffs_(i)), householder_work_.data());
+    }
+
+    evals = all_evals_.segment(lo, nbands) * scale;
+    return Eigen::Success;
+#endif
+}
@@ -1,6 +1,9 @@
 #include "kubo.hpp"
+#include "distributed.hpp"
+#include <algorithm>
 #include <cmath>
 #include <complex>
+#include <stdexcept>
 
 /// @brief  KuboSolver constructor
 /// @details Initializes the KuboSolver with a Hamiltonian, mesh, and parameters.
@@ -15,18 +18,54 @@ KuboSolver::KuboSolver(const Hamiltonian& H, const Mesh& mesh, double eta,
       temperature_in_kelvin(temperature_in_kelvin),
       energy_scale(energy_scale) {}
 
+template <int Dim>
+void KuboSolver::computeVelocityMatrices(const Eigen::Vector3d& k) {
+    for (int i = 0; i < Dim; ++i) {
+        if (!H.dHdk(k, i, dH_buffer)) {
+            Eigen::Vector3d dk = Eigen::Vector3d::Zero();
+            dk(i) = 1e-5;
+            // Reuse the H(k ± dk) and dH buffers for the finite difference (no per-k allocations)
+            H.Hk(k + dk, H_plus);
+            H.Hk(k - dk, H_minus);
+            dH_buffer = (H_plus - H_minus) / (2.0 * dk(i));
+        }
+
+        // Transform to the eigenbasis
+        const Eigen::MatrixXcd& evecs = eig_ws.evecs;
+        product_buffer.noalias() = dH_buffer * evecs;
+        velocity_matrices[i].noalias() = evecs.adjoint() * product_buffer;
+
+        // Band window: weight of ∂H u_n outside the window, for the truncation bound
+        if (evecs.cols() < evecs.rows()) {
+            out_of_window_weight.resize(3, evecs.cols());
+            out_of_window_weight.row(i) = (product_buffer.colwise().squaredNorm()
+                                          - velocity_matrices[i].colwise().squaredNorm()).cwiseMax(0.0);
+            dH_norm2(i) = dH_buffer.squaredNorm();
+        }
+    }
+}
+
 static inline double fermi(double e, double Ef, double beta) {
     const double x = beta * (e - Ef);
     return 1.0 / (std::exp(x) + 1.0);
 }
 
 std::tuple<Eigen::Matrix3d, Eigen::Matrix3d, Eigen::Matrix3d> KuboSolver::computeTransportTensors(double Ef, double T) {
+    if (mesh.dimension() == 2) return computeTransportTensorsImpl<2>(Ef, T);
+    return computeTransportTensorsImpl<3>(Ef, T);
+}
+
+/// @brief Kubo kernel specialised at compile time for 2D or 3D meshes
+/// @details z-velocities vanish identically on 2D meshes, so for Dim = 2 neither the
+/// z velocity matrix nor any z tensor component is evaluated.
+template <int Dim>
+std::tuple<Eigen::Matrix3d, Eigen::Matrix3d, Eigen::Matrix3d> KuboSolver::computeTransportTensorsImpl(double Ef, double T) {
     using namespace Eigen;
     using std::complex;
 
     constexpr double kB = 8.617333262e-5; // eV/K
     const double beta = 1.0 / (temperature_in_kelvin ? (kB * T) : T);
-    const double norm_factor = 1.0/ mesh.size(); // Normalization factor for averaging over k-points
+    const std::vector<double>& weights = mesh.weights(); // k-point weights (sum to 1)
     constexpr double e2_over_h = 1.0 / (2 * M_PI); // e^2/h in unitless form
 
 
@@ -34,60 +73,133 @@ std::tuple<Eigen::Matrix3d, Eigen::Matrix3d, Eigen::Matrix3d> KuboSolver::comput
     Matrix3d L1 = Matrix3d::Zero(); // Thermoelectric
     Matrix3d L2 = Matrix3d::Zero(); // Thermal
 
-    //VectorXd evals;
-    //MatrixXcd evecs;
 
-    for (const auto& k : mesh.getKPoints()) {
-        H.eigensystem(k, evals, evecs);
+    // Each MPI rank sums over its own block of the mesh (the whole mesh without MPI)
+    const auto& kpoints = mesh.getKPoints();
+    const auto [k_begin, k_end] = Distributed::localRange(kpoints.size());
+
+    stats = KuboStats();
+    stats.kpoints = k_end - k_begin;
+    double truncation = 0.0;
+
+    if (progress) progress->start(k_end - k_begin);
+    for (size_t ik = k_begin; ik < k_end; ++ik) {
+        if (progress) progress->add();
+        const auto& k = kpoints[ik];
+        const double wk = weights[ik];
+        H.eigensystem(k, eig_ws);
+        const VectorXd& evals = eig_ws.evals;
         const int N = evals.size();
+        stats.orbitals = static_cast<int>(eig_ws.evecs.rows());
+        stats.bands = N;
 
-        // Compute full velocity operator matrices v_i(n, m) = <n|∂H/∂k_i|m>
-        std::array<MatrixXcd, 3> v;
-        for (int i = 0; i < 3; ++i) {
-            Vector3d dk = Vector3d::Zero();
-            dk(i) = 1e-5;
-            // Reuse dH_buffer for finite difference calculation
-            dH_buffer = (H.Hk(k + dk) - H.Hk(k - dk)) / (2.0 * dk(i));
-            velocity_matrices[i] = evecs.adjoint() * dH_buffer * evecs;  // transformed to eigenbasis
-        }
+        // Velocity operator matrices v_i(n, m) = <n|∂H/∂k_i|m> for the in-mesh directions
+        dH_norm2.setZero();
+        out_of_window_weight.setZero();
+        computeVelocityMatrices<Dim>(k);
 
-        // Kubo formula sum over bands
-        for (int n = 0; n < N; ++n) {
-            const double E_n = evals[n];
-            const double f_n = fermi(E_n, Ef, beta);
+        // Occupations once per k-point
+        occupations.resize(N);
+        for (int n = 0; n < N; ++n) occupations(n) = fermi(evals[n], Ef, beta);
 
-            for (int m = 0; m < N; ++m) {
-                if (n == m) continue;
+        // Pair buffers stay N x N; each k-point uses their top-left block
+        pair_weight.resize(N, N);
+        pair_energy.resize(N, N);
+        pair_weight_1.resize(N, N);
+        pair_weight_2.resize(N, N);
+        pair_im.resize(N, N);
+
+        // Occupation window (evals are ascending): bands [0, n_full) are fully occupied and
+        // bands [n_empty, N) fully empty to within occupation_tolerance. Pairs inside either
+        // set have f_n - f_m ≈ 0, so only rows [0, n_empty) x columns [n_full, N) are visited.
+        int n_full = 0, n_empty = N;
+        while (n_full < N && occupations(n_full) >= 1.0 - occupation_tolerance) ++n_full;
+        while (n_empty > 0 && occupations(n_empty - 1) <= occupation_tolerance) --n_empty;
+        const int rows = n_empty, col0 = std::min(n_full, N), cols = N - col0;
 
-                const double E_m = evals[m];
-                const double deltaE = E_n - E_m;
-                const double f_diff =f_n - fermi(E_m, Ef, beta);
-                const double denom = deltaE * deltaE + eta * eta;
-                const double factor = f_diff / denom;
-                const double omega = (E_n + E_m) / 2.0 - Ef;
+        // The summand is symmetric under n <-> m, so only n < m is kept and the sum doubled
+        long long visited = 0;
+        if (rows > 0 && cols > 0) {
+            const auto E_r = evals.head(rows).array().replicate(1, cols);
+            const auto E_c = evals.tail(cols).transpose().array().replicate(rows, 1);
+            const auto f_r = occupations.head(rows).array().replicate(1, cols);
+            const auto f_c = occupations.tail(cols).transpose().array().replicate(rows, 1);
 
-                for (int i = 0; i < 3; ++i) {
-                    const complex<double> vnm_i = velocity_matrices[i](n, m);
-                    for (int j = 0; j < 3; ++j) {
-                        const complex<double> vmn_j = velocity_matrices[j](m, n);
+            // Band-pair weights F(n,m) = (f_n - f_m) / ((E_n - E_m)² + η²) and energies ω(n,m) = (E_n + E_m)/2 - Ef
+            auto F = pair_weight.topLeftCorner(rows, cols);
+            F = 2.0 * (f_r - f_c) / ((E_r - E_c).square() + eta * eta);
+            for (int n = col0; n < rows; ++n) {             // overlap of the row and column ranges:
+                F.row(n).head(n - col0 + 1).setZero();      // drop m <= n
+            }
+            auto W = pair_energy.topLeftCorner(rows, cols);
+            W = 0.5 * (E_r + E_c) - Ef;
+            pair_weight_1.topLeftCorner(rows, cols) = F * W;
+            pair_weight_2.topLeftCorner(rows, cols) = pair_weight_1.topLeftCorner(rows, cols) * W;
 
-                        double imagPart = std::imag(vnm_i * vmn_j);
+            const long long overlap = std::max(0, rows - col0);
+            visited = static_cast<long long>(rows) * cols - overlap * (overlap + 1) / 2;
+        }
+        stats.pairsVisited += static_cast<size_t>(visited);
+        stats.pairsTotal += static_cast<size_t>(N) * (N - 1) / 2;
 
-                        L0(i, j) += factor * imagPart;
-                        L1(i, j) += factor * imagPart * omega;
-                        L2(i, j) += factor * imagPart * omega * omega;
-                    }
-                }
+        // Band window: bound the dropped pairs (|f_n - f_m| from the monotonic Fermi function,
+        // energy gaps to the nearest excluded eigenvalues, Cauchy–Schwarz on the velocities)
+        if (stats.bands < stats.orbitals) {
+            const double below = eig_ws.excludedBelow, above = eig_ws.excludedAbove;
+            const double f_below = std::isfinite(below) ? fermi(below, Ef, beta) : 1.0;
+            const double f_above = std::isfinite(above) ? fermi(above, Ef, beta) : 0.0;
+            const double eta2 = eta * eta;
+
+            for (int n = 0; n < N; ++n) {
+                const double gap_below = evals[n] - below, gap_above = above - evals[n];
+                const double max_weight = std::max((1.0 - occupations(n)) / (gap_below * gap_below + eta2),
+                                                   occupations(n) / (gap_above * gap_above + eta2));
+                truncation += wk * 2.0 * max_weight * out_of_window_weight.col(n).head<Dim>().maxCoeff();
             }
+            const double cross = (std::isfinite(below) && std::isfinite(above))
+                               ? 1.0 / ((above - below) * (above - below) + eta2) : 0.0;
+            truncation += wk * dH_norm2.head<Dim>().maxCoeff() * (cross + ((1.0 - f_below) + f_above) / eta2);
+        }
+
+        // L_ij is antisymmetric (F(n,m) = -F(m,n), Im(v^i_nm v^j_mn) = -Im(v^i_mn v^j_nm)),
+        // so only i < j is assembled; in 2D this leaves the single xy component.
+        if (visited == 0) continue;
+        for (int i = 0; i < Dim; ++i) {
+            for (int j = i + 1; j < Dim; ++j) {
+                auto P = pair_im.topLeftCorner(rows, cols);
+                P = (velocity_matrices[i].block(0, col0, rows, cols).array()
+                     * velocity_matrices[j].block(col0, 0, cols, rows).transpose().array()).imag();
+
+                L0(i, j) += wk * (pair_weight.topLeftCorner(rows, cols) * P).sum();
+                L1(i, j) += wk * (pair_weight_1.topLeftCorner(rows, cols) * P).sum();
+                L2(i, j) += wk * (pair_weight_2.topLeftCorner(rows, cols) * P).sum();
+            }
+        }
+    }
+    if (progress) progress->finish();
+
+    for (int i = 0; i < Dim; ++i) {
+        for (int j = i + 1; j < Dim; ++j) {
+            L0(j, i) = -L0(i, j);
+            L1(j, i) = -L1(i, j);
+            L2(j, i) = -L2(i, j);
         }
     }
 
-    const double scaling = 2.0 * M_PI * norm_factor * energy_scale * energy_scale * e2_over_h;
+    Distributed::sumAll(L0);
+    Distributed::sumAll(L1);
+    Distributed::sumAll(L2);
+
+    const double scaling = 2.0 * M_PI * energy_scale * energy_scale * e2_over_h;
 
     L0 *= scaling;
     L1 *= scaling;
     L2 *= scaling;
 
+    Distributed::sumAll(&truncation, 1);
+    stats.truncationBound = truncation * scaling;
+    stats.pairsSkipped = stats.pairsTotal - stats.pairsVisited;
+
     Matrix3d sigma = L0;
     Matrix3d alpha = L1 / (T);
     Matrix3d kappa = (L2 - (L1 * L1.transpose()).cwiseQuotient(L0)) / T;
@@ -96,3 +208,181 @@ std::tuple<Eigen::Matrix3d, Eigen::Matrix3d, Eigen::Matrix3d> KuboSolver::comput
     return {sigma, alpha, kappa};
 
 }
+
+
+/// @brief Interband optical conductivity on a frequency grid
+/// @details σ_ij(ω) = i/N Σ_k Σ_{n≠m} (f_n - f_m)/(E_m - E_n) · v^i_nm v^j_mn / (ω + E_n - E_m + iη).
+/// The frequency loop is the innermost loop, so one eigensystem and one set of
+/// velocity matrices per k-point serve every ω.
+/// @param omegas Frequency grid
+/// @param Ef Fermi energy
+/// @param T Temperature
+/// @return OpticalConductivity with one complex tensor per frequency
+OpticalConductivity KuboSolver::computeOpticalConductivity(const std::vector<double>& omegas,
+                                                           double Ef, double T) {
+    if (mesh.dimension() == 2) return computeOpticalConductivityImpl<2>(omegas, Ef, T);
+    return computeOpticalConductivityImpl<3>(omegas, Ef, T);
+}
+
+template <int Dim>
+OpticalConductivity KuboSolver::computeOpticalConductivityImpl(const std::vector<double>& omegas,
+                                                               double Ef, double T) {
+    using namespace Eigen;
+    using std::complex;
+
+    constexpr double kB = 8.617333262e-5; // eV/K
+    const double beta = 1.0 / (temperature_in_kelvin ? (kB * T) : T);
+    const std::vector<double>& weights = mesh.weights();
+    constexpr double e2_over_h = 1.0 / (2 * M_PI);
+    const complex<double> I(0.0, 1.0);
+
+    const Index n_omega = static_cast<Index>(omegas.size());
+
+    // Column w holds the 9 tensor components (column-major) of σ(ω_w)
+    MatrixXcd acc = MatrixXcd::Zero(9, n_omega);
+    Matrix3cd vv = Matrix3cd::Zero();
+    VectorXd f;
+
+    const auto& kpoints = mesh.getKPoints();
+    const auto [k_begin, k_end] = Distributed::localRange(kpoints.size());
+
+    if (progress) progress->start(k_end - k_begin);
+    for (size_t ik = k_begin; ik < k_end; ++ik) {
+        if (progress) progress->add();
+        const auto& k = kpoints[ik];
+        H.eigensystem(k, eig_ws);
+        const VectorXd& evals = eig_ws.evals;
+        computeVelocityMatrices<Dim>(k);
+
+        const int N = evals.size();
+        f.resize(N);
+        for (int n = 0; n < N; ++n) f(n) = fermi(evals[n], Ef, beta);
+
+        for (int n = 0; n < N; ++n) {
+            for (int m = 0; m < N; ++m) {
+                if (n == m) continue;
+
+                const double f_diff = f(n) - f(m);
+                if (f_diff == 0.0) continue;
+
+                const double deltaE = evals[n] - evals[m];
+                if (std::abs(deltaE) < 1e-12) continue; // degenerate pairs carry no interband weight
+
+                // v^i_nm v^j_mn for all in-mesh components, shared by every frequency
+                for (int i = 0; i < Dim; ++i)
+                    for (int j = 0; j < Dim; ++j)
+                        vv(i, j) = velocity_matrices[i](n, m) * velocity_matrices[j](m, n);
+
+                const complex<double> weight = I * weights[ik] * f_diff / (-deltaE);
+                const Map<const Matrix<complex<double>, 9, 1>> vv_flat(vv.data());
+
+                for (Index w = 0; w < n_omega; ++w) {
+                    const complex<double> denom(omegas[w] + deltaE, eta);
+                    acc.col(w) += (weight / denom) * vv_flat;
+                }
+            }
+        }
+    }
+    if (progress) progress->finish();
+
+    Distributed::sumAll(acc);
+
+    const double scaling = 2.0 * M_PI * energy_scale * energy_scale * e2_over_h;
+
+    OpticalConductivity result;
+    result.omega = omegas;
+    result.sigma.resize(omegas.size());
+    for (Index w = 0; w < n_omega; ++w) {
+        result.sigma[w] = Map<const Matrix3cd>(acc.col(w).data()) * scaling;
+    }
+    return result;
+}
+
+
+std::vector<Eigen::Matrix3d> KuboSolver::computeResponseTensors(const std::vector<Eigen::MatrixXcd>& observables,
+                                                                double Ef, double T) {
+    if (mesh.dimension() == 2) return computeResponseTensorsImpl<2>(observables, Ef, T);
+    return computeResponseTensorsImpl<3>(observables, Ef, T);
+}
+
+/// @brief Shared-k-loop kernel for several current operators
+/// @details In the eigenbasis J^O_i = ½(Õ ṽ_i + ṽ_i Õ) with Õ = U† O U, so only Õ is
+/// new per observable; eigenvectors, velocity matrices and pair weights are shared.
+template <int Dim>
+std::vector<Eigen::Matrix3d> KuboSolver::computeResponseTensorsImpl(const std::vector<Eigen::MatrixXcd>& observables,
+                                                                    double Ef, double T) {
+    using namespace Eigen;
+
+    constexpr double kB = 8.617333262e-5; // eV/K
+    const double beta = 1.0 / (temperature_in_kelvin ? (kB * T) : T);
+    const std::vector<double>& weights = mesh.weights();
+    constexpr double e2_over_h = 1.0 / (2 * M_PI);
+
+    const size_t n_obs = observables.size();
+    std::vector<Matrix3d> L0(n_obs, Matrix3d::Zero());
+    projected_observables.resize(n_obs);
+
+    const auto& kpoints = mesh.getKPoints();
+    const auto [k_begin, k_end] = Distributed::localRange(kpoints.size());
+
+    // Observables act on the orbitals of H(k), which outnumber the bands under a band window
+    if (!kpoints.empty()) {
+        H.Hk(kpoints.front(), eig_ws.Hk);
+        const Index orbitals = eig_ws.Hk.rows();
+        for (const MatrixXcd& O : observables) {
+            if (O.rows() != orbitals || O.cols() != orbitals) {
+                throw std::invalid_argument("computeResponseTensors: observable size does not match H(k)");
+            }
+        }
+    }
+
+    if (progress) progress->start(k_end - k_begin);
+    for (size_t ik = k_begin; ik < k_end; ++ik) {
+        if (progress) progress->add();
+        const auto& k = kpoints[ik];
+        H.eigensystem(k, eig_ws);
+        const VectorXd& evals = eig_ws.evals;
+        const MatrixXcd& evecs = eig_ws.evecs;
+        const int N = evals.size();
+
+        computeVelocityMatrices<Dim>(k);
+
+        occupations.resize(N);
+        for (int n = 0; n < N; ++n) occupations(n) = fermi(evals[n], Ef, beta);
+
+        const auto E_col = evals.array().replicate(1, N);
+        const auto E_row = evals.transpose().array().replicate(N, 1);
+        const auto f_col = occupations.array().replicate(1, N);
+        const auto f_row = occupations.transpose().array().replicate(N, 1);
+
+        pair_weight = (f_col - f_row) / ((E_col - E_row).square() + eta * eta);
+        pair_weight.matrix().diagonal().setZero();
+
+        for (size_t o = 0; o < n_obs; ++o) {
+            // Õ = U† O U, once per observable and k-point (N x N, projected onto a band window)
+            product_buffer.noalias() = observables[o] * evecs;
+            projected_observables[o].noalias() = evecs.adjoint() * product_buffer;
+            const MatrixXcd& O = projected_observables[o];
+
+            for (int i = 0; i < Dim; ++i) {
+                // J^O_i = ½{Õ, ṽ_i}
+                current_buffer.noalias() = 0.5 * O * velocity_matrices[i];
+                current_buffer.noalias() += 0.5 * velocity_matrices[i] * O;
+
+                for (int j = 0; j < Dim; ++j) {
+                    if (i == j) continue;
+                    pair_im = (current_buffer.array() * velocity_matrices[j].transpose().array()).imag();
+                    L0[o](i, j) += weights[ik] * (pair_weight * pair_im).sum();
+                }
+            }
+        }
+    }
+    if (progress) progress->finish();
+
+    const double scaling = 2.0 * M_PI * energy_scale * energy_scale * e2_over_h;
+    for (auto& L : L0) {
+        Distributed::sumAll(L);
+        L *= scaling;
+    }
+    return L0;
+}
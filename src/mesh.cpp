@@ -1,28 +1,103 @@
 #include "mesh.hpp"
+#include <stdexcept>
+#include <utility>
 
 Mesh::Mesh(size_t nx, size_t ny, size_t nz, double kmax)
-    : nx_(nx), ny_(ny), nz_(nz), kmax_(kmax) {
+    : nx_(nx), ny_(ny), nz_(nz), kmax_(kmax), dimension_(nz > 1 ? 3 : 2) {
     generateMesh();
 }
 
+Mesh::Mesh(std::vector<Vec> kpoints, std::vector<double> weights, int dimension)
+    : kpoints_(std::move(kpoints)), weights_(std::move(weights)) {
+    if (weights_.size() != kpoints_.size()) {
+        throw std::invalid_argument("Mesh: need one weight per k-point");
+    }
+    if (dimension != 2 && dimension != 3) {
+        throw std::invalid_argument("Mesh: dimension must be 2 or 3");
+    }
+    for (const Vec& k : kpoints_) {
+        if (dimension == 2 && k(2) != 0.0) {
+            throw std::invalid_argument("Mesh: a 2D point list must have k_z = 0 (pass dimension 3)");
+        }
+    }
+    nx_ = kpoints_.size();
+    ny_ = 1;
+    nz_ = 1;
+    dimension_ = dimension;
+}
+
+Mesh Mesh::monkhorstPack(const Eigen::Matrix3d& basis, size_t n1, size_t n2, size_t n3,
+                        const Vec& shift) {
+    if (n1 == 0 || n2 == 0 || n3 == 0) {
+        throw std::invalid_argument("Mesh::monkhorstPack: every axis needs at least one point");
+    }
+
+    Mesh mesh;
+    mesh.nx_ = n1;
+    mesh.ny_ = n2;
+    mesh.nz_ = n3;
+    mesh.dimension_ = n3 > 1 ? 3 : 2;
+    mesh.monkhorst_pack_ = true;
+    mesh.basis_ = basis;
+    mesh.shift_ = shift;
+    mesh.kpoints_.reserve(n1 * n2 * n3);
+    for (size_t i = 0; i < n1; ++i) {
+        for (size_t j = 0; j < n2; ++j) {
+            for (size_t k = 0; k < n3; ++k) {
+                const Vec fractional((i + shift(0)) / n1, (j + shift(1)) / n2, (k + shift(2)) / n3);
+                mesh.kpoints_.emplace_back(basis * fractional);
+            }
+        }
+    }
+    mesh.weights_.assign(mesh.kpoints_.size(), 1.0 / static_cast<double>(mesh.kpoints_.size()));
+    return mesh;
+}
+
 const std::vector<Mesh::Vec>& Mesh::getKPoints() const {
     return kpoints_;
 }
 
+const std::vector<double>& Mesh::weights() const {
+    return weights_;
+}
+
 size_t Mesh::size() const {
     return kpoints_.size();
 }
 
+int Mesh::dimension() const {
+    return dimension_;
+}
+
+/// @brief Coordinate of grid index i along an axis with n points
+/// @details A single-point axis (e.g. nz = 1 for 2D meshes) sits at k = 0
+/// instead of dividing by n - 1 = 0.
+double Mesh::coordinate(size_t i, size_t n) const {
+    if (n <= 1) return 0.0;
+    return -kmax_ + 2 * kmax_ * i / (n - 1);
+}
+
+/// @brief Trapezoidal rule on [-kmax, kmax]: the two end points share one interval
+/// @details For a 2π-periodic integrand and kmax = π the end points are the same physical
+/// k-point, and the trapezoidal weights count it exactly once.
+double Mesh::trapezoidWeight(size_t i, size_t n) {
+    if (n <= 1) return 1.0;
+    const double w = 1.0 / static_cast<double>(n - 1);
+    return (i == 0 || i == n - 1) ? 0.5 * w : w;
+}
+
 void Mesh::generateMesh() {
     kpoints_.clear();
+    weights_.clear();
     for (size_t i = 0; i < nx_; ++i) {
         for (size_t j = 0; j < ny_; ++j) {
             for (size_t k = 0; k < nz_; ++k) {
                 Vec kp;
-                kp(0) = -kmax_ + 2 * kmax_ * i / (nx_ - 1);
-                kp(1) = -kmax_ + 2 * kmax_ * j / (ny_ - 1);
-                kp(2) = -kmax_ + 2 * kmax_ * k / (nz_ - 1);
+                kp(0) = coordinate(i, nx_);
+                kp(1) = coordinate(j, ny_);
+                kp(2) = coordinate(k, nz_);
                 kpoints_.emplace_back(kp);
+                weights_.push_back(trapezoidWeight(i, nx_) * trapezoidWeight(j, ny_) * trapezoidWeight(k, nz_));
             }
         }
     }
@@ -0,0 +1,79 @@
+#include "model_validation.hpp"
+#include <algorithm>
+#include <ostream>
+#include <stdexcept>
+
+/// @file model_validation.cpp
+/// @brief Implementation of the opt-in model checks (hermiticity, periodicity, time reversal).
+
+/// @brief Relative deviation ||A - B|| / max(1, ||B||)
+static double relativeError(const Eigen::MatrixXcd& A, const Eigen::MatrixXcd& B) {
+    return (A - B).norm() / std::max(1.0, B.norm());
+}
+
+ValidationReport validateModel(const Hamiltonian& H, const Mesh& mesh,
+                               const ValidationOptions& options) {
+    const auto& kpoints = mesh.getKPoints();
+    const size_t nk = kpoints.size();
+    const size_t samples = (options.samples == 0) ? nk : std::min(options.samples, nk);
+    const size_t stride = (samples == 0) ? 1 : std::max<size_t>(1, nk / samples);
+
+    if (options.checkTimeReversal && options.timeReversalU.size() == 0) {
+        throw std::invalid_argument("validateModel: time-reversal check requested without an operator");
+    }
+
+    const Eigen::Matrix3d basis = H.reciprocalBasis();
+
+    double herm_error = 0.0;
+    double period_error = 0.0;
+    double tr_error = 0.0;
+
+    #pragma omp parallel reduction(max:herm_error, period_error, tr_error)
+    {
+        Hamiltonian::Mat Hk, Hother, Htransformed;
+
+        #pragma omp for schedule(static)
+        for (long long s = 0; s < static_cast<long long>(samples); ++s) {
+            const Eigen::Vector3d& k = kpoints[static_cast<size_t>(s) * stride];
+            H.Hk(k, Hk);
+
+            // Hermiticity: H(k) = H(k)†
+            herm_error = std::max(herm_error, relativeError(Hk.adjoint(), Hk));
+
+            // Periodicity: H(k + b_i) = H(k)
+            if (options.checkPeriodicity) {
+                for (int i = 0; i < 3; ++i) {
+                    H.Hk(k + basis.col(i), Hother);
+                    period_error = std::max(period_error, relativeError(Hother, Hk));
+                }
+            }
+
+            // Time reversal: U H(k)* U† = H(-k)
+            if (options.checkTimeReversal) {
+                H.Hk(-k, Hother);
+                const Eigen::MatrixXcd& U = options.timeReversalU;
+                Htransformed = U * Hk.conjugate() * U.adjoint();
+                tr_error = std::max(tr_error, relativeError(Htransformed, Hother));
+            }
+        }
+    }
+
+    ValidationReport report;
+    report.pointsChecked = samples;
+    report.hermiticityError = herm_error;
+    report.periodicityError = period_error;
+    report.timeReversalError = tr_error;
+    report.hermitian = herm_error <= options.tolerance;
+    report.periodic = !options.checkPeriodicity || period_error <= options.tolerance;
+    report.timeReversalSymmetric = !options.checkTimeReversal || tr_error <= options.tolerance;
+    return report;
+}
+
+std::ostream& operator<<(std::ostream& os, const ValidationReport& report) {
+    auto status = [](bool ok) { return ok ? "OK  " : "FAIL"; };
+    os << "Points checked: " << report.pointsChecked << "\n"
+       << "  [" << status(report.hermitian) << "] hermiticity     max error " << report.hermiticityError << "\n"
+       << "  [" << status(report.periodic) << "] periodicity     max error " << report.periodicityError << "\n"
+       << "  [" << status(report.timeReversalSymmetric) << "] time reversal   max error " << report.timeReversalError << "\n";
+    return os;
+}
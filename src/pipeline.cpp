@@ -0,0 +1,346 @@
+#include "pipeline.hpp"
+#include "distributed.hpp"
+#include <cmath>
+#include <complex>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+/// @file pipeline.cpp
+/// @brief Producer/consumer threads of BandPipeline and the built-in stages.
+
+namespace {
+
+/// @brief Ω_z of band n from the velocity matrices (sign convention of berryCurvatureFHS)
+/// @details 2 Im Σ_m <n|∂_x H|m><m|∂_y H|n> / (E_n - E_m)², degenerate partners skipped,
+/// the same sum as the analytic path of BoltzmannSolver.
+double bandCurvature(const Eigen::VectorXd& evals, const std::array<Eigen::MatrixXcd, 3>& v, Eigen::Index n) {
+    std::complex<double> sum = 0.0;
+    for (Eigen::Index m = 0; m < evals.size(); ++m) {
+        const double gap = evals(n) - evals(m);
+        if (m == n || std::abs(gap) < 1e-8) continue;
+        sum += v[0](n, m) * v[1](m, n) / (gap * gap);
+    }
+    return 2.0 * std::imag(sum);
+}
+
+} // namespace
+
+
+BandPipeline::BandPipeline(const Hamiltonian& H, const Mesh& mesh, const PipelineOptions& options)
+    : H(H), mesh(mesh), options(options) {
+    if (options.chunkSize == 0) throw std::invalid_argument("BandPipeline: chunkSize must be positive");
+}
+
+void BandPipeline::run() {
+    const auto& kpoints = mesh.getKPoints();
+    const auto [k_begin, k_end] = Distributed::localRange(kpoints.size());
+    const size_t n_chunks = (k_end - k_begin + options.chunkSize - 1) / options.chunkSize;
+    const int dimension = mesh.dimension();
+
+    // Band count from the first global k-point, so ranks without k-points size their stages alike
+    Eigen::VectorXd probe;
+    if (!kpoints.empty()) H.eigenvalues(kpoints.front(), probe);
+
+    bool need_velocities = false;
+    for (PipelineStage* stage : stages) {
+        need_velocities = need_velocities || stage->needsVelocities();
+        stage->begin(mesh, probe.size());
+    }
+
+    using ChunkPtr = std::shared_ptr<const BandChunk>;
+    std::vector<std::unique_ptr<BoundedQueue<ChunkPtr>>> queues;
+    for (size_t s = 0; s < stages.size(); ++s) {
+        queues.push_back(std::make_unique<BoundedQueue<ChunkPtr>>(options.queueDepth));
+    }
+
+    // First exception from any thread; it closes every queue so all threads wind down
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    std::atomic<bool> failed{false};
+    auto fail = [&](std::exception_ptr e) {
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = e;
+        }
+        failed = true;
+        for (auto& q : queues) q->close();
+    };
+
+    // Live chunks are counted by the shared_ptr deleter
+    std::atomic<size_t> live{0}, peak{0};
+    auto track = [&](BandChunk* chunk) {
+        const size_t now = live.fetch_add(1) + 1;
+        size_t seen = peak.load();
+        while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+        return ChunkPtr(chunk, [&live](const BandChunk* c) { delete c; live.fetch_sub(1); });
+    };
+
+    std::atomic<size_t> next_chunk{0};
+    auto produce = [&]() {
+        try {
+            EigenWorkspace ws;
+            Eigen::MatrixXcd dH, H_plus, H_minus, product;
+            while (!failed) {
+                const size_t c = next_chunk.fetch_add(1);
+                if (c >= n_chunks) break;
+                const size_t begin = k_begin + c * options.chunkSize;
+                const size_t end = std::min(k_end, begin + options.chunkSize);
+
+                BandChunk* filling = new BandChunk();
+                ChunkPtr chunk = track(filling);
+                BandChunk& data = *filling;
+                data.begin = begin;
+                data.dimension = dimension;
+                data.evals.resize(end - begin);
+                if (need_velocities) data.velocities.resize(end - begin);
+
+                for (size_t ik = begin; ik < end; ++ik) {
+                    const Eigen::Vector3d& k = kpoints[ik];
+                    if (!need_velocities) {
+                        H.eigenvalues(k, ws);
+                        data.evals[ik - begin] = ws.evals;
+                        continue;
+                    }
+                    H.eigensystem(k, ws);
+                    data.evals[ik - begin] = ws.evals;
+
+                    for (int i = 0; i < dimension; ++i) {
+                        if (!H.dHdk(k, i, dH)) {
+                            Eigen::Vector3d step = Eigen::Vector3d::Zero();
+                            step(i) = options.dk;
+                            H.Hk(k + step, H_plus);
+                            H.Hk(k - step, H_minus);
+                            dH = (H_plus - H_minus) / (2.0 * options.dk);
+                        }
+                        product.noalias() = dH * ws.evecs;
+                        data.velocities[ik - begin][i].noalias() = ws.evecs.adjoint() * product;
+                    }
+                }
+                if (progress) progress->add(end - begin);
+
+                for (auto& q : queues) {
+                    if (!q->push(chunk)) return;
+                }
+            }
+        } catch (...) {
+            fail(std::current_exception());
+        }
+    };
+
+    auto consume = [&](size_t s) {
+        ChunkPtr chunk;
+        while (queues[s]->pop(chunk)) {
+            if (!failed) {
+                try {
+                    stages[s]->consume(*chunk);
+                } catch (...) {
+                    fail(std::current_exception());
+                }
+            }
+            chunk.reset();
+        }
+    };
+
+    int n_producers = options.producers > 0 ? options.producers
+                                            : static_cast<int>(std::thread::hardware_concurrency());
+    n_producers = std::max(1, n_producers);
+
+    if (progress) progress->start(k_end - k_begin);
+    std::vector<std::thread> consumers, producers;
+    for (size_t s = 0; s < stages.size(); ++s) consumers.emplace_back(consume, s);
+    for (int p = 0; p < n_producers; ++p) producers.emplace_back(produce);
+
+    for (auto& t : producers) t.join();
+    for (auto& q : queues) q->close();
+    for (auto& t : consumers) t.join();
+    if (progress) progress->finish();
+
+    peak_chunks = peak.load();
+    if (error) std::rethrow_exception(error);
+
+    for (PipelineStage* stage : stages) stage->finish();
+}
+
+
+DOSStage::DOSStage(double Emin, double Emax, int nBins, double sigma)
+    : Emin(Emin), Emax(Emax), sigma(sigma), nBins(nBins) {
+    if (nBins < 1 || !(Emax > Emin)) throw std::invalid_argument("DOSStage: need nBins >= 1 and Emax > Emin");
+}
+
+void DOSStage::begin(const Mesh& m, Eigen::Index) {
+    mesh = &m;
+    const double dE = (Emax - Emin) / nBins;
+    dos_.assign(nBins, 0.0);
+    energies_.resize(nBins);
+    for (int i = 0; i < nBins; ++i) energies_[i] = Emin + (i + 0.5) * dE;
+}
+
+void DOSStage::consume(const BandChunk& chunk) {
+    const double dE = (Emax - Emin) / nBins;
+    const std::vector<double>& weights = mesh->weights();
+
+    for (size_t p = 0; p < chunk.size(); ++p) {
+        const double wk = weights[chunk.begin + p];
+        for (Eigen::Index n = 0; n < chunk.evals[p].size(); ++n) {
+            const double energy = chunk.evals[p](n);
+            // Bins within ~3 sigma, as DOS::computeDOS
+            const int start_bin = std::max(0, int((energy - 3 * sigma - Emin) / dE));
+            const int end_bin = std::min(nBins - 1, int((energy + 3 * sigma - Emin) / dE));
+            for (int bin = start_bin; bin <= end_bin; ++bin) {
+                const double x = (energies_[bin] - energy) / sigma;
+                dos_[bin] += wk * std::exp(-0.5 * x * x) / (sigma * std::sqrt(2 * M_PI));
+            }
+        }
+    }
+}
+
+void DOSStage::finish() {
+    Distributed::sumAll(dos_.data(), dos_.size());
+    const double norm = nBins / (Emax - Emin);
+    for (auto& value : dos_) value *= norm;
+}
+
+
+KuboStage::KuboStage(double Ef, double T, double eta, bool temperature_in_kelvin, double energy_scale)
+    : Ef(Ef), T(T), eta(eta), temperature_in_kelvin(temperature_in_kelvin), energy_scale(energy_scale) {}
+
+void KuboStage::begin(const Mesh& m, Eigen::Index) {
+    mesh = &m;
+    L0.setZero();
+    L1.setZero();
+    L2.setZero();
+}
+
+void KuboStage::consume(const BandChunk& chunk) {
+    constexpr double kB = 8.617333262e-5; // eV/K
+    const double beta = 1.0 / (temperature_in_kelvin ? (kB * T) : T);
+    const std::vector<double>& weights = mesh->weights();
+
+    for (size_t p = 0; p < chunk.size(); ++p) {
+        const double wk = weights[chunk.begin + p];
+        const Eigen::VectorXd& evals = chunk.evals[p];
+        const auto& v = chunk.velocities[p];
+        const Eigen::Index N = evals.size();
+
+        occupations.resize(N);
+        for (Eigen::Index n = 0; n < N; ++n) occupations(n) = 1.0 / (std::exp(beta * (evals(n) - Ef)) + 1.0);
+
+        // Pairs n < m, doubled: F = 2 (f_n - f_m) / ((E_n - E_m)² + η²), W = (E_n + E_m)/2 - Ef
+        for (Eigen::Index n = 0; n < N; ++n) {
+            for (Eigen::Index m = n + 1; m < N; ++m) {
+                const double df = occupations(n) - occupations(m);
+                if (df == 0.0) continue;
+                const double gap = evals(n) - evals(m);
+                const double F = 2.0 * df / (gap * gap + eta * eta);
+                const double W = 0.5 * (evals(n) + evals(m)) - Ef;
+                for (int i = 0; i < chunk.dimension; ++i) {
+                    for (int j = i + 1; j < chunk.dimension; ++j) {
+                        const double P = std::imag(v[i](n, m) * v[j](m, n));
+                        L0(i, j) += wk * F * P;
+                        L1(i, j) += wk * F * W * P;
+                        L2(i, j) += wk * F * W * W * P;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void KuboStage::finish() {
+    for (int i = 0; i < 3; ++i) {
+        for (int j = i + 1; j < 3; ++j) {
+            L0(j, i) = -L0(i, j);
+            L1(j, i) = -L1(i, j);
+            L2(j, i) = -L2(i, j);
+        }
+    }
+    Distributed::sumAll(L0);
+    Distributed::sumAll(L1);
+    Distributed::sumAll(L2);
+
+    // 2π E_scale² e²/h, as KuboSolver
+    const double scaling = energy_scale * energy_scale;
+    sigma_ = scaling * L0;
+    alpha_ = scaling * L1 / T;
+    kappa_ = scaling * (L2 - (L1 * L1.transpose()).cwiseQuotient(L0)) / T;
+}
+
+
+BoltzmannStage::BoltzmannStage(const BoltzmannSolver& solver, double Ef, double T,
+                               const Eigen::Vector3d& gradT, const Eigen::Vector3d& Efield,
+                               const Eigen::Vector3d& Bfield)
+    : solver(solver), Ef(Ef), T(T), gradT(gradT), Efield(Efield), Bfield(Bfield) {}
+
+void BoltzmannStage::begin(const Mesh& m, Eigen::Index) {
+    mesh = &m;
+    sigma_.setZero();
+    alpha_.setZero();
+}
+
+void BoltzmannStage::consume(const BandChunk& chunk) {
+    const std::vector<double>& weights = mesh->weights();
+
+    for (size_t p = 0; p < chunk.size(); ++p) {
+        const Eigen::VectorXd& evals = chunk.evals[p];
+        const auto& v = chunk.velocities[p];
+
+        for (Eigen::Index n = 0; n < evals.size(); ++n) {
+            Eigen::Vector3d v_group = Eigen::Vector3d::Zero();
+            for (int i = 0; i < chunk.dimension; ++i) v_group(i) = v[i](n, n).real();
+            const Eigen::Vector3d omega(0.0, 0.0, chunk.dimension >= 2 ? bandCurvature(evals, v, n) : 0.0);
+
+            const VelocityResult vres = BoltzmannSolver::fieldVelocity(evals(n), Ef, T, v_group, omega,
+                                                                      gradT, Efield, Bfield);
+            solver.accumulateState(evals(n), Ef, T, vres.velocity,
+                                   weights[chunk.begin + p] * vres.phaseSpaceFactor, sigma_, alpha_);
+        }
+    }
+}
+
+void BoltzmannStage::finish() {
+    Distributed::sumAll(sigma_);
+    Distributed::sumAll(alpha_);
+}
+
+
+void BerryCurvatureStage::begin(const Mesh& mesh, Eigen::Index nBands) {
+    if (mesh.dimension() < 2) throw std::invalid_argument("BerryCurvatureStage: needs a 2D or 3D mesh");
+    curvature_.setZero(static_cast<Eigen::Index>(mesh.size()), nBands);
+}
+
+void BerryCurvatureStage::consume(const BandChunk& chunk) {
+    for (size_t p = 0; p < chunk.size(); ++p) {
+        const Eigen::VectorXd& evals = chunk.evals[p];
+        for (Eigen::Index n = 0; n < evals.size(); ++n) {
+            curvature_(static_cast<Eigen::Index>(chunk.begin + p), n) = bandCurvature(evals, chunk.velocities[p], n);
+        }
+    }
+}
+
+void BerryCurvatureStage::finish() {
+    // Rows of other ranks are zero here
+    Distributed::sumAll(curvature_);
+}
+
+
+void QuantumGeometryStage::begin(const Mesh& mesh, Eigen::Index nBands) {
+    const auto nk = static_cast<Eigen::Index>(mesh.size());
+    geometry_.metric.setZero(nk, 6 * nBands);
+    geometry_.curvature.setZero(nk, 3 * nBands);
+}
+
+void QuantumGeometryStage::consume(const BandChunk& chunk) {
+    for (size_t p = 0; p < chunk.size(); ++p) {
+        const Eigen::VectorXd& evals = chunk.evals[p];
+        quantumGeometricTensor(evals, chunk.velocities[p], chunk.dimension, qgt);
+        geometry_.store(static_cast<Eigen::Index>(chunk.begin + p), qgt);
+    }
+}
+
+void QuantumGeometryStage::finish() {
+    // Rows of other ranks are zero here
+    Distributed::sumAll(geometry_.metric);
+    Distributed::sumAll(geometry_.curvature);
+}
@@ -0,0 +1,82 @@
+#include "progress.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+/// @file progress.cpp
+/// @brief Reporter thread and bar formatting for ProgressReporter.
+
+ProgressReporter::ProgressReporter(std::string label, double rate_hz)
+    : ProgressReporter(std::move(label), rate_hz, std::cout) {}
+
+ProgressReporter::ProgressReporter(std::string label, double rate_hz, std::ostream& out)
+    : label_(std::move(label)), period_(1.0 / std::max(rate_hz, 1e-3)), out_(out) {}
+
+ProgressReporter::~ProgressReporter() {
+    if (worker_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        worker_.join();
+    }
+}
+
+void ProgressReporter::start(size_t total) {
+    if (worker_.joinable()) finish();
+
+    total_ = total;
+    count_.store(0, std::memory_order_relaxed);
+    start_time_ = std::chrono::steady_clock::now();
+    stop_ = false;
+    worker_ = std::thread(&ProgressReporter::run, this);
+}
+
+void ProgressReporter::finish() {
+    if (worker_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        worker_.join();
+    }
+    draw();
+    out_ << std::endl;
+}
+
+void ProgressReporter::run() {
+    const auto period = std::chrono::duration<double>(period_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!wake_.wait_for(lock, period, [this] { return stop_; })) {
+        draw();
+    }
+}
+
+void ProgressReporter::draw() {
+    const size_t done = std::min(count(), total_);
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time_).count();
+    const double fraction = total_ > 0 ? static_cast<double>(done) / total_ : 1.0;
+    const double rate = elapsed > 0.0 ? done / elapsed : 0.0;
+
+    // Build the line first so it reaches the stream in one write
+    const int barWidth = 40;
+    const int pos = static_cast<int>(barWidth * fraction);
+    std::ostringstream line;
+    if (!label_.empty()) line << label_ << " ";
+    line << "[";
+    for (int i = 0; i < barWidth; ++i) line << (i < pos ? '=' : (i == pos ? '>' : ' '));
+    line << "] " << static_cast<int>(fraction * 100.0) << "% (" << done << "/" << total_ << ") "
+         << std::fixed << std::setprecision(1) << elapsed << "s, "
+         << std::setprecision(0) << rate << " /s";
+    if (rate > 0.0 && done < total_) {
+        line << ", ETA " << std::setprecision(1) << (total_ - done) / rate << "s";
+    }
+    line << "   \r";
+
+    out_ << line.str();
+    out_.flush();
+}
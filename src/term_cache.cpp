@@ -0,0 +1,135 @@
+#include "term_cache.hpp"
+#include <cstring>
+#include <stdexcept>
+
+/// @file term_cache.cpp
+/// @brief Construction and assembly of cached Hamiltonian terms.
+
+/// @brief Column-major view of an N x N matrix as one cache column
+static Eigen::Map<const Eigen::VectorXcd> flat(const Hamiltonian::Mat& m) {
+    return Eigen::Map<const Eigen::VectorXcd>(m.data(), m.size());
+}
+
+TermCache::TermCache(const Hamiltonian& model, const Mesh& mesh, double dk)
+    : model_(model), nterms_(model.numTerms()), dim_(mesh.dimension()), n_(0), nk_(mesh.size()) {
+    if (nterms_ <= 0) {
+        throw std::invalid_argument("TermCache: model does not provide a term decomposition");
+    }
+    if (nk_ == 0) throw std::invalid_argument("TermCache: empty mesh");
+
+    const auto& kpoints = mesh.getKPoints();
+    std::vector<Hamiltonian::Mat> terms;
+    model_.termMatrices(kpoints[0], terms);
+    n_ = terms[0].rows();
+
+    const Eigen::Index slots = 1 + dim_;
+    data_.resize(n_ * n_, static_cast<Eigen::Index>(nk_) * slots * nterms_);
+
+    index_.reserve(nk_);
+    for (size_t ik = 0; ik < nk_; ++ik) index_.emplace(key(kpoints[ik]), ik);
+
+    #pragma omp parallel
+    {
+        std::vector<Hamiltonian::Mat> plus, minus;
+
+        #pragma omp for schedule(static)
+        for (long ik = 0; ik < static_cast<long>(nk_); ++ik) {
+            const Eigen::Vector3d& k = kpoints[ik];
+            const Eigen::Index base = ik * slots * nterms_;
+
+            model_.termMatrices(k, plus);
+            for (int p = 0; p < nterms_; ++p) data_.col(base + p) = flat(plus[p]);
+
+            for (int i = 0; i < dim_; ++i) {
+                Eigen::Vector3d step = Eigen::Vector3d::Zero();
+                step(i) = dk;
+                model_.termMatrices(k + step, plus);
+                model_.termMatrices(k - step, minus);
+                for (int p = 0; p < nterms_; ++p) {
+                    data_.col(base + (1 + i) * nterms_ + p) = (flat(plus[p]) - flat(minus[p])) / (2.0 * dk);
+                }
+            }
+        }
+    }
+}
+
+std::array<std::uint64_t, 3> TermCache::key(const Eigen::Vector3d& k) {
+    std::array<std::uint64_t, 3> bits;
+    for (int i = 0; i < 3; ++i) {
+        const double x = k(i) + 0.0; // fold -0.0 onto +0.0
+        std::memcpy(&bits[i], &x, sizeof(double));
+    }
+    return bits;
+}
+
+size_t TermCache::KeyHash::operator()(const std::array<std::uint64_t, 3>& key) const noexcept {
+    // 64-bit mix of the three coordinates (splitmix-style finalizer)
+    std::uint64_t h = key[0] * 0x9E3779B97F4A7C15ULL;
+    h ^= key[1] + 0x632BE59BD9B4E019ULL + (h << 6) + (h >> 2);
+    h ^= key[2] + 0x85157AF5ULL + (h << 6) + (h >> 2);
+    h ^= h >> 31;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27;
+    return static_cast<size_t>(h);
+}
+
+std::ptrdiff_t TermCache::find(const Eigen::Vector3d& k) const {
+    const auto it = index_.find(key(k));
+    return it == index_.end() ? -1 : static_cast<std::ptrdiff_t>(it->second);
+}
+
+void TermCache::combine(Eigen::Index first, const Eigen::VectorXd& coefficients, Eigen::MatrixXcd& out) const {
+    out.resize(n_, n_);
+    Eigen::Map<Eigen::VectorXcd> out_flat(out.data(), out.size());
+    out_flat = coefficients(0) * data_.col(first);
+    for (int p = 1; p < nterms_; ++p) out_flat += coefficients(p) * data_.col(first + p);
+}
+
+void TermCache::assemble(size_t ik, const Eigen::VectorXd& coefficients, Eigen::MatrixXcd& out) const {
+    combine(static_cast<Eigen::Index>(ik) * (1 + dim_) * nterms_, coefficients, out);
+}
+
+void TermCache::assembleDerivative(size_t ik, int direction, const Eigen::VectorXd& coefficients,
+                                   Eigen::MatrixXcd& out) const {
+    combine((static_cast<Eigen::Index>(ik) * (1 + dim_) + 1 + direction) * nterms_, coefficients, out);
+}
+
+
+CachedHamiltonian::CachedHamiltonian(const TermCache& cache, const Eigen::VectorXd& coefficients)
+    : cache(cache) {
+    setCoefficients(coefficients);
+}
+
+void CachedHamiltonian::setCoefficients(const Eigen::VectorXd& coefficients) {
+    if (coefficients.size() != cache.numTerms()) {
+        throw std::invalid_argument("CachedHamiltonian: expected one coefficient per term");
+    }
+    coeffs = coefficients;
+}
+
+Hamiltonian::Mat CachedHamiltonian::Hk(const Vec& k) const {
+    Mat out;
+    Hk(k, out);
+    return out;
+}
+
+void CachedHamiltonian::Hk(const Vec& k, Mat& out) const {
+    const std::ptrdiff_t ik = cache.find(k);
+    if (ik >= 0) {
+        cache.assemble(static_cast<size_t>(ik), coeffs, out);
+        return;
+    }
+
+    // Off-mesh point: same linear combination of freshly evaluated terms
+    cache.model().termMatrices(k, scratch_terms);
+    out = coeffs(0) * scratch_terms[0];
+    for (int p = 1; p < cache.numTerms(); ++p) out += coeffs(p) * scratch_terms[p];
+}
+
+bool CachedHamiltonian::dHdk(const Vec& k, int direction, Mat& out) const {
+    if (direction >= cache.dimension()) return false;
+    const std::ptrdiff_t ik = cache.find(k);
+    if (ik < 0) return false;
+    cache.assembleDerivative(static_cast<size_t>(ik), direction, coeffs, out);
+    return true;
+}
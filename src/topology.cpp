@@ -0,0 +1,180 @@
+#include "topology.hpp"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+
+/// @file topology.cpp
+/// @brief Wilson-loop products, WCC flow, Soluyanov–Vanderbilt Z2 counting and lattice Chern numbers.
+
+WilsonLoop::WilsonLoop(const Hamiltonian& H, int nOccupied, size_t nStringPoints)
+    : H(H), nOccupied(nOccupied), nStringPoints(nStringPoints), basis(H.reciprocalBasis()) {
+    if (nOccupied <= 0) throw std::invalid_argument("WilsonLoop: nOccupied must be positive");
+    if (nStringPoints < 2) throw std::invalid_argument("WilsonLoop: need at least two points per string");
+}
+
+
+Eigen::MatrixXcd WilsonLoop::wilsonMatrix(double k1) const {
+    EigenWorkspace ws;
+    Eigen::MatrixXcd first, previous, overlap;
+    Eigen::MatrixXcd W = Eigen::MatrixXcd::Identity(nOccupied, nOccupied);
+    Eigen::MatrixXcd product(nOccupied, nOccupied);
+
+    for (size_t j = 0; j < nStringPoints; ++j) {
+        const Eigen::Vector3d k = k1 * basis.col(0) + (double(j) / double(nStringPoints)) * basis.col(1);
+        H.eigensystem(k, ws); // one diagonalization per string point
+
+        if (ws.evecs.cols() < nOccupied) {
+            throw std::runtime_error("WilsonLoop: more occupied bands than the model has");
+        }
+
+        if (j == 0) {
+            first = ws.evecs.leftCols(nOccupied);
+        } else {
+            overlap.noalias() = previous.adjoint() * ws.evecs.leftCols(nOccupied);
+            product.noalias() = W * overlap;
+            W.swap(product);
+        }
+        previous = ws.evecs.leftCols(nOccupied);
+    }
+
+    // Close the loop: H(k + b2) = H(k), so the last point connects back to the first
+    overlap.noalias() = previous.adjoint() * first;
+    product.noalias() = W * overlap;
+    return product;
+}
+
+
+std::vector<double> WilsonLoop::wannierCenters(double k1) const {
+    const Eigen::MatrixXcd W = wilsonMatrix(k1);
+    Eigen::ComplexEigenSolver<Eigen::MatrixXcd> solver(W, false);
+
+    std::vector<double> centers(static_cast<size_t>(nOccupied));
+    for (int n = 0; n < nOccupied; ++n) {
+        double x = std::arg(solver.eigenvalues()(n)) / (2.0 * M_PI);
+        if (x < 0.0) x += 1.0;
+        if (x >= 1.0) x -= 1.0;
+        centers[static_cast<size_t>(n)] = x;
+    }
+    std::sort(centers.begin(), centers.end());
+    return centers;
+}
+
+
+WannierCenterFlow WilsonLoop::flow(size_t nStrings, double k1_min, double k1_max) const {
+    if (nStrings < 2) throw std::invalid_argument("WilsonLoop::flow: need at least two strings");
+
+    WannierCenterFlow result;
+    result.k1.resize(nStrings);
+    result.centers.resize(nStrings);
+    result.berryPhase.resize(nStrings);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (long long s = 0; s < static_cast<long long>(nStrings); ++s) {
+        const size_t i = static_cast<size_t>(s);
+        const double k1 = k1_min + (k1_max - k1_min) * double(i) / double(nStrings - 1);
+        result.k1[i] = k1;
+        result.centers[i] = wannierCenters(k1);
+
+        double total = 0.0;
+        for (double x : result.centers[i]) total += x;
+        result.berryPhase[i] = total - std::floor(total);
+    }
+    return result;
+}
+
+
+/// @brief Midpoint of the largest gap between neighbouring WCCs on the unit circle
+static double largestGapMidpoint(const std::vector<double>& centers) {
+    if (centers.empty()) return 0.5;
+
+    // Gap across the periodic boundary (from the last centre to the first plus one)
+    double best_gap = centers.front() + 1.0 - centers.back();
+    double midpoint = centers.back() + 0.5 * best_gap;
+
+    for (size_t n = 1; n < centers.size(); ++n) {
+        const double gap = centers[n] - centers[n - 1];
+        if (gap > best_gap) {
+            best_gap = gap;
+            midpoint = centers[n - 1] + 0.5 * gap;
+        }
+    }
+    return midpoint - std::floor(midpoint);
+}
+
+
+int WilsonLoop::z2FromFlow(const WannierCenterFlow& flow) {
+    int crossings = 0;
+
+    for (size_t i = 0; i + 1 < flow.centers.size(); ++i) {
+        const double z_now = largestGapMidpoint(flow.centers[i]);
+        const double z_next = largestGapMidpoint(flow.centers[i + 1]);
+        const double lo = std::min(z_now, z_next);
+        const double hi = std::max(z_now, z_next);
+
+        // WCCs of the next string jumped over by the gap; the gap moves along the
+        // shorter arc, which passes through 0 ≡ 1 when the midpoints are more than 1/2 apart
+        const bool wraps = (hi - lo) > 0.5;
+        for (double x : flow.centers[i + 1]) {
+            const bool between = (x > lo && x < hi);
+            if (between != wraps) ++crossings;
+        }
+    }
+    return crossings % 2;
+}
+
+
+int WilsonLoop::z2Invariant(size_t nStrings) const {
+    return z2FromFlow(flow(nStrings, 0.0, 0.5));
+}
+
+
+int chernNumber(const Hamiltonian& H, int nOccupied, size_t n1, size_t n2) {
+    if (n2 == 0) n2 = n1;
+    if (nOccupied <= 0) throw std::invalid_argument("chernNumber: nOccupied must be positive");
+    if (n1 < 2 || n2 < 2) throw std::invalid_argument("chernNumber: need at least 2 x 2 grid points");
+
+    const Eigen::Matrix3d basis = H.reciprocalBasis();
+    const long N1 = static_cast<long>(n1), N2 = static_cast<long>(n2);
+
+    EigenWorkspace probe;
+    H.eigenvalues(Eigen::Vector3d::Zero(), probe);
+    if (probe.evals.size() < nOccupied) {
+        throw std::runtime_error("chernNumber: more occupied bands than the model has");
+    }
+
+    // Occupied eigenvectors at every grid point; indices wrap, so H(k + b) = H(k) closes the links
+    std::vector<Eigen::MatrixXcd> occupied(n1 * n2);
+    #pragma omp parallel
+    {
+        EigenWorkspace ws;
+        #pragma omp for schedule(static)
+        for (long p = 0; p < N1 * N2; ++p) {
+            const Eigen::Vector3d k = (double(p / N2) / N1) * basis.col(0) + (double(p % N2) / N2) * basis.col(1);
+            H.eigensystem(k, ws);
+            occupied[p] = ws.evecs.leftCols(nOccupied);
+        }
+    }
+
+    auto at = [&](long i, long j) -> const Eigen::MatrixXcd& {
+        return occupied[((i % N1) * N2) + (j % N2)];
+    };
+    auto link = [](const Eigen::MatrixXcd& a, const Eigen::MatrixXcd& b) {
+        return (a.adjoint() * b).determinant();
+    };
+
+    double total = 0.0;
+    for (long i = 0; i < N1; ++i) {
+        for (long j = 0; j < N2; ++j) {
+            const std::complex<double> plaquette = link(at(i, j), at(i + 1, j))
+                                                 * link(at(i + 1, j), at(i + 1, j + 1))
+                                                 * link(at(i + 1, j + 1), at(i, j + 1))
+                                                 * link(at(i, j + 1), at(i, j));
+            total += std::arg(plaquette);
+        }
+    }
+
+    // Plaquettes are traversed b1 → b2; flip for a left-handed (b1, b2)
+    const double orientation = (basis(0, 0) * basis(1, 1) - basis(1, 0) * basis(0, 1)) < 0.0 ? -1.0 : 1.0;
+    return static_cast<int>(std::lround(orientation * total / (2.0 * M_PI)));
+}
@@ -0,0 +1,129 @@
+#include "two_band.hpp"
+#include <cmath>
+#include <complex>
+
+/// @file two_band.cpp
+/// @brief Closed-form eigensystem, derivatives and band geometry of TwoBandModel.
+
+
+void TwoBandModel::writePauli(double e, const Eigen::Vector3d& d, Mat& out) {
+    out.resize(2, 2);
+    out(0, 0) = e + d(2);
+    out(0, 1) = std::complex<double>(d(0), -d(1));
+    out(1, 0) = std::complex<double>(d(0), d(1));
+    out(1, 1) = e - d(2);
+}
+
+
+void TwoBandModel::Hk(const Vec& k, Mat& out) const {
+    double eps;
+    Eigen::Vector3d d;
+    pauliVector(k, eps, d);
+    writePauli(eps, d, out);
+}
+
+
+void TwoBandModel::eigensystem(const Vec& k, Eigen::VectorXd& evals, Eigen::MatrixXcd& evecs) const {
+    EigenWorkspace ws(2);
+    eigensystem(k, ws);
+    evals = ws.evals;
+    evecs = ws.evecs;
+}
+
+
+void TwoBandModel::eigensystem(const Vec& k, EigenWorkspace& ws) const {
+    double eps;
+    Eigen::Vector3d d;
+    pauliVector(k, eps, d);
+    writePauli(eps, d, ws.Hk);
+    if (ws.evecs.rows() != 2 || ws.evecs.cols() != 2) ws.resize(2);
+
+    const double r = d.norm();
+    ws.evals(0) = eps - r;
+    ws.evals(1) = eps + r;
+    ws.excludedBelow = -std::numeric_limits<double>::infinity();
+    ws.excludedAbove = std::numeric_limits<double>::infinity();
+
+    if (r == 0.0) {
+        ws.evecs.setIdentity();
+        return;
+    }
+
+    // Upper band (a, b); the lower band is its orthogonal partner (-b*, a*)
+    std::complex<double> a, b;
+    if (d(2) >= 0.0) {
+        const double norm = 1.0 / std::sqrt(2.0 * r * (r + d(2)));
+        a = (r + d(2)) * norm;
+        b = std::complex<double>(d(0), d(1)) * norm;
+    } else {
+        const double norm = 1.0 / std::sqrt(2.0 * r * (r - d(2)));
+        a = std::complex<double>(d(0), -d(1)) * norm;
+        b = (r - d(2)) * norm;
+    }
+    ws.evecs(0, 0) = -std::conj(b);
+    ws.evecs(1, 0) = std::conj(a);
+    ws.evecs(0, 1) = a;
+    ws.evecs(1, 1) = b;
+}
+
+
+void TwoBandModel::eigenvalues(const Vec& k, Eigen::VectorXd& evals) const {
+    double eps;
+    Eigen::Vector3d d;
+    pauliVector(k, eps, d);
+    const double r = d.norm();
+    evals.resize(2);
+    evals << eps - r, eps + r;
+}
+
+
+void TwoBandModel::eigenvalues(const Vec& k, EigenWorkspace& ws) const {
+    eigenvalues(k, ws.evals);
+    ws.excludedBelow = -std::numeric_limits<double>::infinity();
+    ws.excludedAbove = std::numeric_limits<double>::infinity();
+}
+
+
+bool TwoBandModel::dHdk(const Vec& k, int direction, Mat& out) const {
+    Eigen::Vector3d grad_eps;
+    Eigen::Matrix3d grad_d;
+    pauliGradient(k, grad_eps, grad_d);
+    writePauli(grad_eps(direction), grad_d.col(direction), out);
+    return true;
+}
+
+
+bool TwoBandModel::d2Hdk2(const Vec& k, int i, int j, Mat& out) const {
+    double eps_ij;
+    Eigen::Vector3d d_ij;
+    if (!pauliHessian(k, i, j, eps_ij, d_ij)) return false;
+    writePauli(eps_ij, d_ij, out);
+    return true;
+}
+
+
+void TwoBandModel::bandGeometry(const Vec& k, TwoBandGeometry& out) const {
+    double eps;
+    Eigen::Vector3d d, grad_eps;
+    Eigen::Matrix3d grad_d;
+    pauliVector(k, eps, d);
+    pauliGradient(k, grad_eps, grad_d);
+
+    const double r = d.norm();
+    out.energies << eps - r, eps + r;
+
+    // At d = 0, <n|∂_i H|n> in the standard basis returned by eigensystem; else ∂_i |d| = d̂·∂_i d
+    const Eigen::Vector3d grad_r = (r == 0.0) ? Eigen::Vector3d(-grad_d.row(2).transpose())
+                                              : Eigen::Vector3d(grad_d.transpose() * d / r);
+    out.velocities.col(0) = grad_eps - grad_r;
+    out.velocities.col(1) = grad_eps + grad_r;
+
+    if (r < 5e-9) {
+        out.omega.setZero();
+        return;
+    }
+
+    // d̂·(∂_x d̂ × ∂_y d̂) = d·(∂_x d × ∂_y d) / |d|³
+    const double solid_angle = d.dot(grad_d.col(0).cross(grad_d.col(1))) / (r * r * r);
+    out.omega << -0.5 * solid_angle, 0.5 * solid_angle;
+}
@@ -0,0 +1,103 @@
+#include "haldane.hpp"
+#include "altermagnet.hpp"
+#include "kane_mele.hpp"
+#include "mesh.hpp"
+#include "kubo.hpp"
+#include "boltzmann.hpp"
+#include "dos.hpp"
+#include <iostream>
+#include <cstdlib>
+#include <functional>
+
+/*
+Heap allocations per k-point must be zero in steady state.
+
+Every malloc in the process is counted (Eigen and operator new both end up in malloc).
+A solver call on a small and on a larger mesh must allocate the same number of times:
+setup costs are allowed, anything that scales with the number of k-points is not.
+The counter relies on glibc's __libc_malloc and is skipped on other C libraries.
+*/
+
+#if defined(__GLIBC__)
+static size_t g_allocations = 0;
+static bool g_counting = false;
+
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* malloc(size_t size) {
+    if (g_counting) ++g_allocations;
+    return __libc_malloc(size);
+}
+
+static size_t countAllocations(const std::function<void()>& work) {
+    g_allocations = 0;
+    g_counting = true;
+    work();
+    g_counting = false;
+    return g_allocations;
+}
+
+static bool check(const std::string& name, size_t small, size_t large) {
+    const bool ok = (small == large);
+    std::cout << name << ": " << small << " allocations (small mesh), "
+              << large << " (large mesh) -> " << (ok ? "OK" : "FAIL") << std::endl;
+    return ok;
+}
+#endif
+
+int main() {
+#if defined(__GLIBC__)
+    HaldaneModel haldane(1.0, 0.1, M_PI / 2.0, 0.2);
+    AltermagnetModel altermagnet(1.0, 0.5, 0.1);
+    Mesh small(6, 6);
+    Mesh large(24, 24);
+
+    bool ok = true;
+
+    // Bare eigensystem loop
+    EigenWorkspace ws;
+    haldane.eigensystem(small.getKPoints()[0], ws); // size the workspace
+    auto diagonalize = [&](const Mesh& mesh) {
+        return countAllocations([&] {
+            for (const auto& k : mesh.getKPoints()) haldane.eigensystem(k, ws);
+        });
+    };
+    ok &= check("EigenWorkspace", diagonalize(small), diagonalize(large));
+
+    // Eigenvalues only, through the generic tridiagonal path (coupled 4x4)
+    KaneMeleModel rashba(1.0, 0.1, 0.2, true);
+    rashba.lambda_R = 0.05;
+    rashba.eigenvalues(small.getKPoints()[0], ws);
+    auto energies = [&](const Mesh& mesh) {
+        return countAllocations([&] {
+            for (const auto& k : mesh.getKPoints()) rashba.eigenvalues(k, ws);
+        });
+    };
+    ok &= check("EigenWorkspace eigenvalues", energies(small), energies(large));
+
+    // Solvers (a warm-up call sizes the solver-owned buffers)
+    KuboSolver kubo_small(altermagnet, small, 1e-2), kubo_large(altermagnet, large, 1e-2);
+    kubo_small.computeTransportTensors(0.5, 0.02);
+    kubo_large.computeTransportTensors(0.5, 0.02);
+    ok &= check("KuboSolver",
+                countAllocations([&] { kubo_small.computeTransportTensors(0.5, 0.02); }),
+                countAllocations([&] { kubo_large.computeTransportTensors(0.5, 0.02); }));
+
+    const Eigen::Vector3d E(1.0, 0.0, 0.0), gradT(1.0, 0.0, 0.0), B(0.0, 0.0, 0.0);
+    BoltzmannSolver bolt_small(altermagnet, small, 1.0), bolt_large(altermagnet, large, 1.0);
+    bolt_small.computeTransportTensors(0.5, 0.02, gradT, E, B);
+    bolt_large.computeTransportTensors(0.5, 0.02, gradT, E, B);
+    ok &= check("BoltzmannSolver",
+                countAllocations([&] { bolt_small.computeTransportTensors(0.5, 0.02, gradT, E, B); }),
+                countAllocations([&] { bolt_large.computeTransportTensors(0.5, 0.02, gradT, E, B); }));
+
+    DOS dos_small(haldane, small), dos_large(haldane, large);
+    ok &= check("DOS",
+                countAllocations([&] { dos_small.computeDOS(-4.0, 4.0, 200, 0.05); }),
+                countAllocations([&] { dos_large.computeDOS(-4.0, 4.0, 200, 0.05); }));
+
+    return ok ? 0 : 1;
+#else
+    std::cout << "Allocation counting requires glibc; skipped." << std::endl;
+    return 0;
+#endif
+}
@@ -0,0 +1,107 @@
+#include "haldane.hpp"
+#include "mesh.hpp"
+#include "boltzmann.hpp"
+#include "band_interpolation.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include "test_models.hpp"
+
+/// @brief max |a - b| / max |b|
+double relativeError(const Eigen::Matrix3d& a, const Eigen::Matrix3d& b) {
+    return (a - b).cwiseAbs().maxCoeff() / std::max(b.cwiseAbs().maxCoeff(), 1e-30);
+}
+
+int main() {
+    using clock = std::chrono::steady_clock;
+    auto seconds = [](clock::time_point a, clock::time_point b) { return std::chrono::duration<double>(b - a).count(); };
+    HaldaneModel H(1.0, 0.1, M_PI / 2.0, 0.2);
+
+    // 1. Interpolant from a coarse 24 x 24 grid of the reciprocal cell
+    BandInterpolator bands(H, 24, 24);
+    std::cout << "Coarse diagonalizations: " << bands.coarseSize()
+              << ", bands: " << bands.numBands() << std::endl;
+
+    // Energies and velocities at random k-points against direct diagonalization
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> uniform(-M_PI, M_PI);
+    InterpolationWorkspace iws;
+    EigenWorkspace ws;
+    Eigen::VectorXd energies;
+    Eigen::MatrixXd velocities;
+    double max_energy_error = 0.0, max_velocity_error = 0.0;
+    const double dk = 1e-5;
+
+    for (int s = 0; s < 200; ++s) {
+        const Eigen::Vector3d k(uniform(rng), uniform(rng), 0.0);
+        bands.evaluate(k, iws, energies, velocities);
+
+        H.eigensystem(k, ws);
+        max_energy_error = std::max(max_energy_error, (energies - ws.evals).cwiseAbs().maxCoeff());
+
+        for (int d = 0; d < 2; ++d) {
+            Eigen::Vector3d step = Eigen::Vector3d::Zero();
+            step(d) = dk;
+            H.eigensystem(k + step, ws);
+            const Eigen::VectorXd ep = ws.evals;
+            H.eigensystem(k - step, ws);
+            const Eigen::VectorXd v_exact = (ep - ws.evals) / (2.0 * dk);
+            max_velocity_error = std::max(max_velocity_error,
+                                          (velocities.row(d).transpose() - v_exact).cwiseAbs().maxCoeff());
+        }
+    }
+    std::cout << "max |E_interp - E_exact| = " << max_energy_error << std::endl;
+    std::cout << "max |v_interp - v_exact| = " << max_velocity_error << std::endl;
+
+    // 2. Dense Monkhorst–Pack grid (shifted, not a multiple of the coarse grid) against evaluate
+    const Mesh shifted = Mesh::monkhorstPack(H.reciprocalBasis(), 50, 36, 1, Eigen::Vector3d(0.5, 0.25, 0.0));
+    Eigen::MatrixXd grid_energies;
+    std::array<Eigen::MatrixXd, 3> grid_velocities;
+    bands.evaluateGrid(shifted, 7, shifted.size() - 5, grid_energies, grid_velocities);
+    double grid_error = 0.0;
+    for (size_t ik = 7; ik < shifted.size() - 5; ++ik) {
+        bands.evaluate(shifted.getKPoints()[ik], iws, energies, velocities);
+        const Eigen::Index row = static_cast<Eigen::Index>(ik - 7);
+        grid_error = std::max(grid_error, (grid_energies.row(row).transpose() - energies).cwiseAbs().maxCoeff());
+        for (int c = 0; c < 3; ++c) {
+            grid_error = std::max(grid_error, (grid_velocities[c].row(row) - velocities.row(c)).cwiseAbs().maxCoeff());
+        }
+    }
+    std::cout << "evaluateGrid vs evaluate: max |difference| = " << grid_error << std::endl;
+
+    // 3. Dense-mesh Boltzmann conductivity (no fields, so D_n = 1): two-band Haldane
+    const Eigen::Vector3d zero = Eigen::Vector3d::Zero();
+    const Mesh dense = Mesh::monkhorstPack(H.reciprocalBasis(), 120, 120);
+    BoltzmannSolver solver(H, dense, 1.0);
+    const double Ef = 0.5, T = 0.05;
+    auto [sigma_direct, alpha_direct] = solver.computeTransportTensors(Ef, T, zero, zero, zero);
+    auto [sigma_interp, alpha_interp] = solver.computeTransportTensors(bands, dense, Ef, T);
+    const double haldane_sigma_error = relativeError(sigma_interp, sigma_direct);
+    std::cout << "Haldane σ (direct):\n" << sigma_direct << "\nHaldane σ (interpolated):\n" << sigma_interp
+              << "\nrelative error " << haldane_sigma_error << std::endl;
+
+    // 4. Many bands, where a dense point costs a full eigensolve: interpolation from 16 x 16 vs direct
+    const IsolatedBandsModel model(24, 3);
+    const Mesh model_dense = Mesh::monkhorstPack(model.reciprocalBasis(), 96, 96);
+    BoltzmannSolver model_solver(model, model_dense, 1.0);
+    const double Ef_model = 11.7, T_model = 0.05;
+
+    const auto t0 = clock::now();
+    auto [sigma_model_direct, alpha_model_direct] = model_solver.computeTransportTensors(Ef_model, T_model, zero, zero, zero);
+    const auto t1 = clock::now();
+    const BandInterpolator model_bands(model, 16, 16);
+    auto [sigma_model_interp, alpha_model_interp] = model_solver.computeTransportTensors(model_bands, model_dense, Ef_model, T_model);
+    const auto t2 = clock::now();
+
+    const double model_sigma_error = relativeError(sigma_model_interp, sigma_model_direct);
+    const double speedup = seconds(t0, t1) / seconds(t1, t2);
+    std::cout << "24 bands, " << model_dense.size() << " k-points: direct " << seconds(t0, t1)
+              << " s, interpolated (incl. fit) " << seconds(t1, t2) << " s, speedup " << speedup
+              << ", σ relative error " << model_sigma_error << std::endl;
+
+    const bool ok = max_energy_error < 5e-3 && max_velocity_error < 5e-2 && grid_error < 1e-10
+                    && haldane_sigma_error < 2e-2 && model_sigma_error < 1e-3 && speedup > 1.0;
+    std::cout << (ok ? "OK" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
+}
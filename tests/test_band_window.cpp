@@ -0,0 +1,170 @@
+#include "hamiltonian.hpp"
+#include "windowed_hamiltonian.hpp"
+#include "altermagnet.hpp"
+#include "mesh.hpp"
+#include "kubo.hpp"
+#include "boltzmann.hpp"
+#include <chrono>
+#include <complex>
+#include <iostream>
+#include "test_models.hpp"
+
+/*
+Random nearest-neighbour tight-binding model with N orbitals per cell:
+H(k) = H0 + (H1 e^{ikx} + H2 e^{iky} + h.c.), fixed seed.
+*/
+class RandomSupercell : public Hamiltonian {
+public:
+    explicit RandomSupercell(int N) {
+        std::srand(11);
+        H0 = Mat::Random(N, N);
+        H0 = (0.5 * (H0 + H0.adjoint())).eval();
+        H1 = 0.3 * Mat::Random(N, N);
+        H2 = 0.3 * Mat::Random(N, N);
+    }
+
+    Mat Hk(const Vec& k) const override {
+        const std::complex<double> ex = std::polar(1.0, k(0)), ey = std::polar(1.0, k(1));
+        Mat H = H0 + ex * H1 + ey * H2;
+        H += (ex * H1 + ey * H2).adjoint().eval();
+        return H;
+    }
+
+private:
+    Mat H0, H1, H2;
+};
+
+int main() {
+    const int N = 120;
+    RandomSupercell model(N);
+    Mesh mesh(8, 8);
+    const double Ef = 0.0, T = 0.05, eta = 0.05;
+
+    // Eigenpairs of the window agree with the full spectrum
+    EigenWorkspace full, window;
+    const Eigen::Vector3d k(0.3, -1.1, 0.0);
+    model.eigensystem(k, full);
+    WindowedHamiltonian windowed(model, 30, Ef);
+    windowed.eigensystem(k, window);
+    const double residual = (window.Hk * window.evecs - window.evecs * window.evals.asDiagonal()).norm();
+    std::cout << "Window [" << window.evals(0) << ", " << window.evals(window.evals.size() - 1)
+              << "], excluded neighbours " << window.excludedBelow << " / " << window.excludedAbove
+              << ", residual " << residual << std::endl;
+
+    // Kubo on the full spectrum and on shrinking windows around Ef
+    KuboSolver kubo_full(model, mesh, eta);
+    auto t0 = std::chrono::steady_clock::now();
+    auto [sigma_full, alpha_full, kappa_full] = kubo_full.computeTransportTensors(Ef, T);
+    auto t1 = std::chrono::steady_clock::now();
+    std::cout << "full spectrum: sigma_xy = " << sigma_full(0, 1)
+              << "  (" << std::chrono::duration<double>(t1 - t0).count() << " s)" << std::endl;
+
+    // Occupation pruning: at low T only pairs across the Fermi level are visited
+    const KuboStats& full_stats = kubo_full.lastStats();
+    std::cout << "band pairs visited " << full_stats.pairsVisited << " of " << full_stats.pairsTotal
+              << " (" << 100.0 * full_stats.pairsSkipped / full_stats.pairsTotal << "% skipped)" << std::endl;
+
+    bool bounded = true;
+    std::cout << "# bands  sigma_xy  |error|  bound  time[s]\n";
+    for (int nbands : {90, 60, 30}) {
+        WindowedHamiltonian H(model, nbands, Ef);
+        KuboSolver kubo(H, mesh, eta);
+        auto t2 = std::chrono::steady_clock::now();
+        auto [sigma, alpha, kappa] = kubo.computeTransportTensors(Ef, T);
+        auto t3 = std::chrono::steady_clock::now();
+        const KuboStats& stats = kubo.lastStats();
+        const bool within = std::abs(sigma(0, 1) - sigma_full(0, 1)) <= stats.truncationBound;
+        bounded = bounded && within;
+        std::cout << stats.bands << "  " << sigma(0, 1) << "  " << std::abs(sigma(0, 1) - sigma_full(0, 1))
+                  << "  " << stats.truncationBound << "  " << std::chrono::duration<double>(t3 - t2).count()
+                  << (within ? "" : "  BOUND VIOLATED") << "\n";
+    }
+
+    // Response tensors take full-size observables and project them onto the window
+    WindowedHamiltonian H30(model, 30, Ef);
+    KuboSolver kubo30(H30, mesh, eta);
+    auto [sigma30, alpha30, kappa30] = kubo30.computeTransportTensors(Ef, T);
+    const auto responses = kubo30.computeResponseTensors({Eigen::MatrixXcd::Identity(N, N)}, Ef, T);
+    std::cout << "window of 30, identity observable: sigma_xy = " << responses[0](0, 1)
+              << " (computeTransportTensors " << sigma30(0, 1) << ")" << std::endl;
+
+    // Above iterativeWindowMinOrbitals solveWindow runs the shift-invert subspace iteration,
+    // warm-started along a path of k-points: same window as the full diagonalization, orthonormal
+    // eigenvectors, excluded neighbours between the window and the true ones
+    const int N_large = 768, nb_large = 16;
+    RandomSupercell large(N_large);
+    EigenWorkspace large_full, large_window;
+    bool iterative = true, bracketed = true;
+    double large_eval_error = 0.0, large_residual = 0.0, large_orthogonality = 0.0;
+    for (int step = 0; step < 4; ++step) {
+        const Eigen::Vector3d kp(0.3 + 0.05 * step, -1.1, 0.0);
+        large_full.Hk = large.Hk(kp);
+        large_full.solve();
+        large_window.Hk = large_full.Hk;
+        large_window.solveWindow(nb_large, Ef);
+        iterative = iterative && large_window.windowIterations > 0;
+
+        const Eigen::VectorXd& all = large_full.evals;
+        Eigen::Index lo = 0; // first of the nb_large eigenvalues closest to Ef
+        while (lo + nb_large < N_large && Ef - all(lo) > all(lo + nb_large) - Ef) ++lo;
+        large_eval_error = std::max(large_eval_error,
+                                    (large_window.evals - all.segment(lo, nb_large)).cwiseAbs().maxCoeff());
+        large_residual = std::max(large_residual, (large_window.Hk * large_window.evecs
+                                                   - large_window.evecs * large_window.evals.asDiagonal()).norm());
+        large_orthogonality = std::max(large_orthogonality,
+                                       (large_window.evecs.adjoint() * large_window.evecs
+                                        - Eigen::MatrixXd::Identity(nb_large, nb_large)).norm());
+        bracketed = bracketed && large_window.excludedBelow >= all(lo - 1) - 1e-9
+                    && large_window.excludedBelow < large_window.evals(0)
+                    && large_window.excludedAbove <= all(lo + nb_large) + 1e-9
+                    && large_window.excludedAbove > large_window.evals(nb_large - 1);
+    }
+    const bool large_ok = iterative && bracketed && large_eval_error < 1e-10 && large_residual < 1e-8
+                          && large_orthogonality < 1e-10;
+    std::cout << "N = " << N_large << ", window of " << nb_large << " (iterative " << (iterative ? "yes" : "NO")
+              << ", " << large_window.windowIterations << " steps at the last k): eigenvalue error "
+              << large_eval_error << ", residual " << large_residual << ", orthogonality " << large_orthogonality
+              << ", excluded neighbours " << (bracketed ? "conservative" : "WRONG") << std::endl;
+
+    // Kubo through the iterative window stays within its truncation bound
+    const Mesh large_mesh(2, 2);
+    KuboSolver large_kubo_full(large, large_mesh, eta);
+    const WindowedHamiltonian large_windowed(large, nb_large, Ef);
+    KuboSolver large_kubo(large_windowed, large_mesh, eta);
+    const double large_sigma_full = std::get<0>(large_kubo_full.computeTransportTensors(Ef, T))(0, 1);
+    const double large_sigma = std::get<0>(large_kubo.computeTransportTensors(Ef, T))(0, 1);
+    const double large_bound = large_kubo.lastStats().truncationBound;
+    const bool large_bounded = std::abs(large_sigma - large_sigma_full) <= large_bound;
+    std::cout << "N = " << N_large << ", window of " << nb_large << ": sigma_xy = " << large_sigma << " (full "
+              << large_sigma_full << "), |error| " << std::abs(large_sigma - large_sigma_full) << ", bound "
+              << large_bound << (large_bounded ? "" : "  BOUND VIOLATED") << std::endl;
+
+    // The wrapper keeps the analytic derivatives and term decomposition of the model
+    const AltermagnetModel altermagnet(1.0, 0.5, 0.1);
+    const WindowedHamiltonian wrapped(altermagnet, 2, Ef);
+    Eigen::MatrixXcd dH_model, dH_wrapped;
+    const bool forwarded = altermagnet.dHdk(k, 0, dH_model) && wrapped.dHdk(k, 0, dH_wrapped)
+                           && (dH_model - dH_wrapped).norm() == 0.0
+                           && wrapped.numTerms() == altermagnet.numTerms();
+    std::cout << "window forwards dHdk and terms: " << (forwarded ? "yes" : "NO") << std::endl;
+
+    // Boltzmann with fields on a window of an analytic-∂H model: the Berry curvature of the window
+    // bands must not lose the bands outside it, so the Hall σ_xy (Berry-phase terms only)
+    // matches the full model
+    const IsolatedBandsModel isolated(16, 5);
+    const WindowedHamiltonian isolated_window(isolated, 4, 7.5);
+    const Mesh bolt_mesh(40, 40);
+    const double Ef_bolt = 7.5 + 0.2, tau = 10.0;
+    const Eigen::Vector3d E_field(1.0, 0.0, 0.0), B_field(0.0, 0.0, 1.0), zero = Eigen::Vector3d::Zero();
+    const auto [sigma_bolt, alpha_bolt] = BoltzmannSolver(isolated, bolt_mesh, tau, false, 1.0)
+                                              .computeTransportTensors(Ef_bolt, T, zero, E_field, B_field);
+    const auto [sigma_bolt_window, alpha_bolt_window] = BoltzmannSolver(isolated_window, bolt_mesh, tau, false, 1.0)
+                                                            .computeTransportTensors(Ef_bolt, T, zero, E_field, B_field);
+    const double bolt_error = std::abs(sigma_bolt_window(0, 1) - sigma_bolt(0, 1)) / std::abs(sigma_bolt(0, 1));
+    std::cout << "Boltzmann with fields, window of 4 of 16 bands: sigma_xy = " << sigma_bolt_window(0, 1)
+              << " (full " << sigma_bolt(0, 1) << "), relative error " << bolt_error << std::endl;
+
+    const bool ok = bounded && large_ok && large_bounded && forwarded && bolt_error < 2e-2;
+    std::cout << (ok ? "OK" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -1,6 +1,9 @@
 #include "mesh.hpp"
 #include "haldane.hpp"
 #include "geometry.hpp"
+#include "test_models.hpp"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 
@@ -12,4 +15,46 @@ int main() {
         double Omega = berryCurvatureFHS(model, k);
         std::cout << k.head<2>().transpose() << " " << Omega << std::endl;
     }
+
+    // Batched call over all k-points and bands must match the per-band FHS values (plaquettes:
+    // HaldaneModel itself would take the two-band closed form)
+    const HkOnly plaquette(model);
+    BerryWorkspace ws;
+    Eigen::MatrixXd batch = berryCurvatureBatch(plaquette, mesh.getKPoints(), 1e-3, ws);
+
+    double max_diff = 0.0;
+    for (size_t ik = 0; ik < mesh.size(); ++ik) {
+        for (int n = 0; n < batch.cols(); ++n) {
+            double single = berryCurvatureFHS(plaquette, mesh.getKPoints()[ik], 1e-3, n, ws);
+            max_diff = std::max(max_diff, std::abs(single - batch(ik, n)));
+        }
+    }
+    std::cout << "# max |batch - single| = " << max_diff << std::endl;
+
+    // The two-band dispatch agrees with the plaquettes up to their O(dk) offset
+    const Eigen::MatrixXd closed_form = berryCurvatureBatch(model, mesh.getKPoints(), 1e-3, ws);
+    const double closed_form_diff = (closed_form - batch).cwiseAbs().maxCoeff() / batch.cwiseAbs().maxCoeff();
+    std::cout << "# max |closed form - FHS| / max |FHS| = " << closed_form_diff << std::endl;
+
+    // Sign convention: FHS plaquettes, the differential sum over states and the quantum geometric
+    // tensor agree in sign and magnitude (and a sign flip would show as |difference| ~ 2 |Omega|)
+    double max_omega = 0.0, differential_diff = 0.0, qgt_diff = 0.0;
+    QuantumGeometricTensor qgt;
+    for (size_t ik = 0; ik < mesh.size(); ++ik) {
+        const Eigen::Vector3d& k = mesh.getKPoints()[ik];
+        quantumGeometricTensor(model, k, 2, 1e-4, ws, qgt);
+        for (int n = 0; n < batch.cols(); ++n) {
+            const double fhs = berryCurvatureFHS(plaquette, k, 1e-4, n, ws);
+            max_omega = std::max(max_omega, std::abs(fhs));
+            differential_diff = std::max(differential_diff, std::abs(berryCurvatureDifferential(model, k, 1e-3, n, ws) - fhs));
+            qgt_diff = std::max(qgt_diff, std::abs(qgt.curvature(n)(2) - fhs));
+        }
+    }
+    std::cout << "# max |Omega| = " << max_omega << ", max |differential - FHS| = " << differential_diff
+              << ", max |QGT - FHS| = " << qgt_diff << std::endl;
+
+    const bool ok = max_diff == 0.0 && closed_form_diff < 1e-2 && max_omega > 0.1
+                    && differential_diff < 1e-3 * max_omega && qgt_diff < 1e-3 * max_omega;
+    std::cout << (ok ? "OK" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
 }
@@ -1,6 +1,7 @@
 #include "haldane.hpp"       // Your sample Hamiltonian (Haldane model)
 #include "mesh.hpp"
 #include "boltzmann.hpp"
+#include <algorithm>
 #include <iostream>
 #include <Eigen/Dense>
 
@@ -34,5 +35,23 @@ int main() {
 
     std::cout << "Conductivity tensor (σ_ij):\n" << sigma << std::endl;
     std::cout << "Thermopower tensor (α_ij):\n" << alpha << std::endl;
-    return 0;
+
+    // Transport distribution Σ(E): one mesh pass, then a temperature scan by 1D convolution
+    TransportDistribution dist = solver.computeTransportDistribution(-4.0, 4.0, 4001, Efield, Bfield);
+    const Eigen::Vector3d noGradT = Eigen::Vector3d::Zero();
+    // Both tensors must agree with the direct mesh sum to the grid resolution (relative 1e-3)
+    bool ok = true;
+    std::cout << "\n# T   sigma_xx(direct)   sigma_xx(Sigma(E))   alpha_xx(direct)   alpha_xx(Sigma(E))\n";
+    for (double Ts : {0.05, 0.1, 0.2}) {
+        auto [sigma_d, alpha_d] = solver.computeTransportTensors(0.5, Ts, noGradT, Efield, Bfield);
+        TransportCoefficients c = dist.coefficients(0.5, Ts);
+        const double sigma_err = (c.sigma - sigma_d).cwiseAbs().maxCoeff() / std::max(sigma_d.cwiseAbs().maxCoeff(), 1e-300);
+        const double alpha_err = (c.alpha - alpha_d).cwiseAbs().maxCoeff() / std::max(alpha_d.cwiseAbs().maxCoeff(), 1e-300);
+        const bool match = sigma_err < 1e-3 && alpha_err < 1e-3;
+        std::cout << Ts << "  " << sigma_d(0, 0) << "  " << c.sigma(0, 0)
+                  << "  " << alpha_d(0, 0) << "  " << c.alpha(0, 0) << (match ? "" : "  FAIL") << std::endl;
+        ok = ok && match;
+    }
+    std::cout << (ok ? "OK" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
 }
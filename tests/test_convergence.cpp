@@ -0,0 +1,80 @@
+#include "haldane.hpp"
+#include "altermagnet.hpp"
+#include "convergence.hpp"
+#include "kubo.hpp"
+#include "boltzmann.hpp"
+#include "dos.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+/*
+Automatic mesh convergence: nested Monkhorst-Pack meshes with Richardson extrapolation,
+compared with a brute-force run on a much larger mesh.
+*/
+
+/// @brief Simple cubic nearest-neighbour band E(k) = -2 (cos kx + cos ky + cos kz)
+class CubicBand : public Hamiltonian {
+public:
+    Mat Hk(const Vec& k) const override {
+        return Mat::Constant(1, 1, -2.0 * (std::cos(k(0)) + std::cos(k(1)) + std::cos(k(2))));
+    }
+};
+
+int main() {
+    const int xy = 3; // σ_xy in the column-major [σ, α] vector
+
+    // Kubo σ_xy of the Haldane model
+    HaldaneModel haldane(1.0, 0.1, M_PI / 2.0, 0.2);
+    ConvergenceOptions kubo_options;
+    kubo_options.tolerance = 1e-5;
+    kubo_options.components = {xy};
+    ConvergenceResult kubo = convergeKubo(haldane, 0.05, 0.0, 0.05, 2, kubo_options);
+    std::cout << "Kubo sigma_xy:\n" << kubo;
+
+    const Mesh reference_mesh = Mesh::monkhorstPack(haldane.reciprocalBasis(), 512, 512);
+    KuboSolver reference(haldane, reference_mesh, 0.05);
+    auto [sigma_ref, alpha_ref, kappa_ref] = reference.computeTransportTensors(0.0, 0.05);
+    std::cout << "converged " << kubo.value(xy) << ", 512x512 mesh " << sigma_ref(0, 1)
+              << ", |difference| " << std::abs(kubo.value(xy) - sigma_ref(0, 1)) << "\n\n";
+
+    // Boltzmann σ_xx of the altermagnet
+    AltermagnetModel altermagnet(1.0, 0.3, 0.5);
+    const Eigen::Vector3d zero = Eigen::Vector3d::Zero();
+    ConvergenceOptions bolt_options;
+    bolt_options.tolerance = 1e-4;
+    bolt_options.components = {0};
+    ConvergenceResult bolt = convergeBoltzmann(altermagnet, 1.0, 0.5, 0.05, zero, zero, zero, 2, bolt_options);
+    std::cout << "Boltzmann sigma_xx:\n" << bolt;
+
+    const Mesh bolt_mesh = Mesh::monkhorstPack(altermagnet.reciprocalBasis(), 512, 512);
+    BoltzmannSolver bolt_reference(altermagnet, bolt_mesh, 1.0);
+    auto [sigma_b, alpha_b] = bolt_reference.computeTransportTensors(0.5, 0.05, zero, zero, zero);
+    std::cout << "converged " << bolt.value(0) << ", 512x512 mesh " << sigma_b(0, 0)
+              << ", |difference| " << std::abs(bolt.value(0) - sigma_b(0, 0)) << std::endl;
+
+    // 3D: the levels refine b3 as well, and the finest value is the plain average over the full 16^3 mesh
+    const CubicBand cubic;
+    ConvergenceOptions dos_options;
+    dos_options.initialPoints = 8;
+    dos_options.maxLevels = 2;
+    const ConvergenceResult dos3d = convergeDOS(cubic, -6.5, 6.5, 40, 0.5, 3, dos_options);
+    const Mesh full_mesh = MeshConvergence(cubic.reciprocalBasis(), 3).refinementPoints(16, true);
+    const std::vector<double> dos_full = DOS(cubic, full_mesh).computeDOS(-6.5, 6.5, 40, 0.5);
+    double dos_difference = 0.0;
+    for (int i = 0; i < 40; ++i) dos_difference = std::max(dos_difference, std::abs(dos3d.finestMesh(i) - dos_full[i]));
+    const bool dos3d_ok = dos3d.history.size() == 2 && dos3d.history[1].newPoints == 16 * 16 * 16 - 8 * 8 * 8
+                          && dos_difference < 1e-12;
+    std::cout << "3D DOS: " << dos3d.history.back().newPoints << " new points on the 16^3 level, max |finest - 16^3 mesh| "
+              << dos_difference << std::endl;
+
+    // Both runs converge, land within their tolerance of the large mesh, and do not
+    // underestimate their error by more than a factor 10
+    const double kubo_difference = std::abs(kubo.value(xy) - sigma_ref(0, 1));
+    const double bolt_difference = std::abs(bolt.value(0) - sigma_b(0, 0));
+    const bool ok = dos3d_ok && kubo.converged && bolt.converged
+                    && kubo_difference < kubo_options.tolerance && bolt_difference < bolt_options.tolerance
+                    && kubo_difference < 10.0 * kubo.errorEstimate && bolt_difference < 10.0 * bolt.errorEstimate;
+    std::cout << (ok ? "OK" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,112 @@
+#include "haldane.hpp"
+#include "kane_mele.hpp"
+#include "windowed_hamiltonian.hpp"
+#include "mesh.hpp"
+#include "dos.hpp"
+#include <algorithm>
+#include <chrono>
+#include <complex>
+#include <iostream>
+#include "test_models.hpp"
+
+/*
+Eigenvalues-only path (Hamiltonian::eigenvalues) against the full eigensystem:
+closed-form 2x2, block-diagonal and coupled 4x4, a generic multi-band model and the
+band window, then the DOS run time with and without eigenvectors.
+*/
+
+/// @brief Random nearest-neighbour tight-binding model with N orbitals per cell (fixed seed)
+class RandomSupercell : public Hamiltonian {
+public:
+    explicit RandomSupercell(int N) {
+        std::srand(5);
+        H0 = Mat::Random(N, N);
+        H0 = (0.5 * (H0 + H0.adjoint())).eval();
+        H1 = 0.3 * Mat::Random(N, N);
+        H2 = 0.3 * Mat::Random(N, N);
+    }
+
+    Mat Hk(const Vec& k) const override {
+        const std::complex<double> ex = std::polar(1.0, k(0)), ey = std::polar(1.0, k(1));
+        Mat H = H0 + ex * H1 + ey * H2;
+        H += (ex * H1 + ey * H2).adjoint().eval();
+        return H;
+    }
+
+private:
+    Mat H0, H1, H2;
+};
+
+/// @brief Energies through the full eigensystem, as energy-only consumers did before
+class WithEigenvectors : public Hamiltonian {
+public:
+    using Hamiltonian::eigenvalues;
+    explicit WithEigenvectors(const Hamiltonian& model) : model(model) {}
+    Mat Hk(const Vec& k) const override { return model.Hk(k); }
+    void eigenvalues(const Vec& k, EigenWorkspace& ws) const override { model.eigensystem(k, ws); }
+private:
+    const Hamiltonian& model;
+};
+
+/// @brief Largest |eigenvalues - eigensystem evals| over a mesh
+double maxDeviation(const Hamiltonian& H, const Mesh& mesh) {
+    EigenWorkspace full, values;
+    Eigen::VectorXd plain;
+    double err = 0.0;
+    for (const auto& k : mesh.getKPoints()) {
+        H.eigensystem(k, full);
+        H.eigenvalues(k, values);
+        H.eigenvalues(k, plain);
+        err = std::max(err, (values.evals - full.evals).cwiseAbs().maxCoeff());
+        err = std::max(err, (plain - full.evals).cwiseAbs().maxCoeff());
+    }
+    return err;
+}
+
+int main() {
+    using clock = std::chrono::steady_clock;
+    auto seconds = [](clock::time_point a, clock::time_point b) { return std::chrono::duration<double>(b - a).count(); };
+    const Mesh mesh(20, 20);
+
+    // 1. Every closed form and the tridiagonal path agree with the eigensystem
+    const HaldaneModel haldane(1.0, 0.1, M_PI / 2.0, 0.2);
+    const HkOnly haldane_generic(haldane);
+    const KaneMeleModel kane_mele(1.0, 0.1, 0.2, false);
+    KaneMeleModel rashba(1.0, 0.1, 0.2, true);
+    rashba.lambda_R = 0.05;
+    const RandomSupercell supercell(60);
+    const WindowedHamiltonian window(supercell, 8, 0.0);
+
+    double err = 0.0;
+    for (const auto& [name, model] : {std::make_pair("Haldane (two-band model)", static_cast<const Hamiltonian*>(&haldane)),
+                                      std::make_pair("Haldane (generic 2x2)", static_cast<const Hamiltonian*>(&haldane_generic)),
+                                      std::make_pair("Kane-Mele (decoupled 4x4)", static_cast<const Hamiltonian*>(&kane_mele)),
+                                      std::make_pair("Kane-Mele + Rashba (4x4)", static_cast<const Hamiltonian*>(&rashba)),
+                                      std::make_pair("Random supercell N = 60", static_cast<const Hamiltonian*>(&supercell)),
+                                      std::make_pair("Window of 8 bands", static_cast<const Hamiltonian*>(&window))}) {
+        const double e = maxDeviation(*model, mesh);
+        err = std::max(err, e);
+        std::cout << name << ": max |eigenvalues - eigensystem| = " << e << "\n";
+    }
+
+    // 2. DOS with eigenvalues only vs the same DOS through the eigensystem
+    const Mesh dos_mesh(24, 24);
+    DOS dos(supercell, dos_mesh);
+    const auto t0 = clock::now();
+    const std::vector<double> values = dos.computeDOS(-6.0, 6.0, 300, 0.05);
+    const auto t1 = clock::now();
+
+    const WithEigenvectors previous(supercell);
+    DOS dos_previous(previous, dos_mesh);
+    const std::vector<double> reference = dos_previous.computeDOS(-6.0, 6.0, 300, 0.05);
+    const auto t2 = clock::now();
+
+    double dos_err = 0.0;
+    for (size_t bin = 0; bin < values.size(); ++bin) dos_err = std::max(dos_err, std::abs(values[bin] - reference[bin]));
+    std::cout << "DOS (N = 60, " << dos_mesh.size() << " k-points): eigenvalues " << seconds(t0, t1)
+              << " s, eigensystem " << seconds(t1, t2) << " s, max |difference| " << dos_err << "\n";
+
+    const bool ok = err < 1e-10 && dos_err < 1e-10;
+    std::cout << (ok ? "OK" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
+}
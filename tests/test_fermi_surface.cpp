@@ -0,0 +1,76 @@
+#include "altermagnet.hpp"
+#include "mesh.hpp"
+#include "boltzmann.hpp"
+#include "fermi_surface.hpp"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+/*
+Low-temperature Boltzmann transport: mesh sum of (-∂f/∂E) v v versus line integrals
+over the Fermi contours. The mesh result approaches the contour result as T → 0 only
+if the mesh resolves the thermal shell; the contour result needs neither.
+*/
+
+int main() {
+    AltermagnetModel model(1.0, 0.3, 0.5);
+    const double Ef = 0.5, tau = 1.0;
+    const Eigen::Vector3d zero = Eigen::Vector3d::Zero();
+
+    // Length check: ε = -2t(cos kx + cos ky) is a circle of radius r near the band bottom
+    AltermagnetModel free(1.0, 0.0, 0.0);
+    const double r = 0.2;
+    const double E_circle = -4.0 + r * r - r * r * r * r / 12.0; // -2(cos kx + cos ky) on |k| = r, O(r⁶)
+    FermiSurfaceGrid free_grid(free, 256);
+    // The (2π, ±2π) unit cell holds two copies of the 2π-periodic band
+    const double copies = free_grid.cellArea() / (4.0 * M_PI * M_PI);
+    const double length = free_grid.contours(E_circle).length(0) / copies;
+    const double length_error = std::abs(length - 2.0 * M_PI * r) / (2.0 * M_PI * r);
+    std::cout << "circle: length per band " << length << " (exact " << 2.0 * M_PI * r << ")" << std::endl;
+
+    // Contour transport for increasing grid resolution
+    Mesh unused(2, 2);
+    BoltzmannSolver solver(model, unused, tau);
+    Eigen::Matrix3d sigma_contour, alpha_contour, sigma_contour_coarse;
+    std::cout << "# contour grid  sigma_xx  sigma_yy  alpha_xx (T=0.05)  time[s]\n";
+    for (size_t n : {16, 32, 64, 128}) {
+        auto t0 = std::chrono::steady_clock::now();
+        auto [sigma, alpha] = solver.computeFermiSurfaceTransport(Ef, 0.05, n);
+        sigma_contour_coarse = sigma_contour;
+        sigma_contour = sigma;
+        alpha_contour = alpha;
+        auto t1 = std::chrono::steady_clock::now();
+        std::cout << n << "  " << sigma(0, 0) << "  " << sigma(1, 1) << "  " << alpha(0, 0)
+                  << "  " << std::chrono::duration<double>(t1 - t0).count() << "\n";
+    }
+
+    // Mesh sums at finite T (no fields)
+    Eigen::Matrix3d sigma_mesh, alpha_mesh;
+    std::cout << "# mesh  T  sigma_xx  sigma_yy  alpha_xx  time[s]\n";
+    for (size_t N : {100, 200, 400}) {
+        Mesh mesh(N, N, 1, M_PI);
+        BoltzmannSolver bolt(model, mesh, tau);
+        for (double T : {0.05, 0.01}) {
+            auto t0 = std::chrono::steady_clock::now();
+            auto [sigma, alpha] = bolt.computeTransportTensors(Ef, T, zero, zero, zero);
+            if (T == 0.05) {
+                sigma_mesh = sigma;
+                alpha_mesh = alpha;
+            }
+            auto t1 = std::chrono::steady_clock::now();
+            std::cout << N << "  " << T << "  " << sigma(0, 0) << "  " << sigma(1, 1) << "  " << alpha(0, 0)
+                      << "  " << std::chrono::duration<double>(t1 - t0).count() << "\n";
+        }
+    }
+
+    // The finest mesh resolves the T = 0.05 shell: it and the converged contours must agree
+    const double contour_convergence = std::abs(sigma_contour(0, 0) - sigma_contour_coarse(0, 0)) / sigma_contour(0, 0);
+    const double sigma_error = std::abs(sigma_contour(0, 0) - sigma_mesh(0, 0)) / sigma_mesh(0, 0);
+    const double alpha_error = std::abs(alpha_contour(0, 0) - alpha_mesh(0, 0)) / std::abs(alpha_mesh(0, 0));
+    std::cout << "circle length error " << length_error << ", contour 64 -> 128 change " << contour_convergence
+              << ", contour vs 400² mesh at T = 0.05: sigma_xx " << sigma_error << ", alpha_xx " << alpha_error << std::endl;
+
+    const bool ok = length_error < 1e-2 && contour_convergence < 1e-3 && sigma_error < 2e-3 && alpha_error < 5e-2;
+    std::cout << (ok ? "OK" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
+}
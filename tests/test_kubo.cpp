@@ -1,8 +1,15 @@
 #include "haldane.hpp"       // Your sample Hamiltonian (Haldane model)
 #include "mesh.hpp"
 #include "kubo.hpp"
+#include <algorithm>
+#include <complex>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 #include <Eigen/Dense>
+#include <cmath>
+#include <tuple>
+#include "test_models.hpp"
 
 int main() {
     // Set up k-mesh
@@ -30,5 +37,66 @@ int main() {
 
     std::cout << "Conductivity tensor (σ_ij):\n" << sigma << std::endl;
 
-    return 0;
+    // Optical conductivity on a frequency grid from a single k-loop
+    std::vector<double> omegas;
+    for (int w = 0; w <= 10; ++w) omegas.push_back(0.5 * w);
+    OpticalConductivity optical = solver.computeOpticalConductivity(omegas, Ef, T);
+
+    std::cout << "# omega\tRe sigma_xx\tIm sigma_xx\tRe sigma_xy\tIm sigma_xy\n";
+    for (size_t w = 0; w < omegas.size(); ++w) {
+        const auto& s = optical.sigma[w];
+        std::cout << omegas[w] << "\t" << s(0, 0).real() << "\t" << s(0, 0).imag()
+                  << "\t" << s(0, 1).real() << "\t" << s(0, 1).imag() << "\n";
+    }
+
+    // Re σ_xx(ω) is absorptive (non-negative) at every frequency
+    double min_absorption = std::numeric_limits<double>::infinity();
+    for (const auto& s : optical.sigma) min_absorption = std::min(min_absorption, s(0, 0).real());
+
+    // ω → 0 reproduces the DC Hall conductivity. The two kernels regularize with η differently
+    // (1/(ΔE + ω + iη) against a Lorentzian in ΔE), which differ at O(η / gap): compare at small η.
+    const double eta_dc = 1e-5;
+    KuboSolver sharp(H, mesh, eta_dc, false, 1.0);
+    const double sigma_dc = std::get<0>(sharp.computeTransportTensors(Ef, T))(0, 1);
+    const std::complex<double> sigma_static = sharp.computeOpticalConductivity({0.0}, Ef, T).sigma[0](0, 1);
+    const double static_error = std::abs(sigma_static - sigma_dc);
+    std::cout << "sigma_xy(omega = 0) = " << sigma_static << ", DC sigma_xy = " << sigma_dc << " (eta = " << eta_dc
+              << ", |difference| " << static_error << "), min Re sigma_xx(omega) = " << min_absorption << std::endl;
+    const bool optical_ok = min_absorption >= 0.0 && std::abs(sigma_dc) > 1e-2
+                            && static_error < 1e-5 * std::abs(sigma_dc);
+
+    // Charge and spin Hall responses of the spinful Haldane model from one k-loop: the charge
+    // response is computeTransportTensors, the spin response σ_xy(up) - σ_xy(down)
+    const SpinfulHaldane spinful(0.1, M_PI / 2.0, 0.2);
+    KuboSolver spinful_solver(spinful, mesh, eta, false, 1.0);
+    const Eigen::MatrixXcd charge = Eigen::MatrixXcd::Identity(4, 4);
+    Eigen::MatrixXcd spin_z = Eigen::MatrixXcd::Zero(4, 4);
+    spin_z.diagonal() << 1.0, 1.0, -1.0, -1.0;
+
+    auto responses = spinful_solver.computeResponseTensors({charge, spin_z}, Ef, T);
+    auto [charge_sigma, charge_alpha, charge_kappa] = spinful_solver.computeTransportTensors(Ef, T);
+    KuboSolver up_solver(spinful.spinUp(), mesh, eta, false, 1.0), down_solver(spinful.spinDown(), mesh, eta, false, 1.0);
+    const Eigen::Matrix3d sigma_up = std::get<0>(up_solver.computeTransportTensors(Ef, T));
+    const Eigen::Matrix3d sigma_down = std::get<0>(down_solver.computeTransportTensors(Ef, T));
+
+    const double scale = std::abs(sigma_up(0, 1));
+    const double charge_error = std::abs(responses[0](0, 1) - charge_sigma(0, 1));
+    const double spin_error = std::abs(responses[1](0, 1) - (sigma_up(0, 1) - sigma_down(0, 1)));
+    std::cout << "Spinful Haldane sigma_xy: charge " << responses[0](0, 1)
+              << " (computeTransportTensors " << charge_sigma(0, 1) << ")"
+              << ", spin " << responses[1](0, 1) << " (up - down " << sigma_up(0, 1) - sigma_down(0, 1) << ")" << std::endl;
+
+    // An observable of the wrong size is rejected before the k-loop starts
+    bool rejected = false;
+    try {
+        spinful_solver.computeResponseTensors({charge, Eigen::MatrixXcd::Identity(2, 2)}, Ef, T);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    std::cout << "2 x 2 observable on a 4-orbital model: " << (rejected ? "rejected" : "ACCEPTED") << std::endl;
+
+    const bool ok = optical_ok && scale > 1e-3 && charge_error < 1e-10 * scale && spin_error < 1e-10 * scale
+                    && rejected;
+    std::cout << (ok ? "OK" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
 }
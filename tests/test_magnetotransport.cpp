@@ -0,0 +1,176 @@
+#include "haldane.hpp"
+#include "altermagnet.hpp"
+#include "mesh.hpp"
+#include "boltzmann.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <Eigen/Dense>
+
+/// @brief Nearest-neighbour square lattice, one band ε = -2t (cos kx + cos ky)
+class SquareLattice : public Hamiltonian {
+public:
+    Mat Hk(const Vec& k) const override {
+        Mat H(1, 1);
+        H(0, 0) = -2.0 * (std::cos(k(0)) + std::cos(k(1)));
+        return H;
+    }
+};
+
+/// @brief Same H(k) as the wrapped model, without its analytic derivatives
+class HkOnly : public Hamiltonian {
+public:
+    explicit HkOnly(const Hamiltonian& model) : model(model) {}
+    Mat Hk(const Vec& k) const override { return model.Hk(k); }
+    Eigen::Matrix3d reciprocalBasis() const override { return model.reciprocalBasis(); }
+private:
+    const Hamiltonian& model;
+};
+
+/// @brief Reference Hessian from four eigensolves per entry
+Eigen::Matrix3d finiteDifferenceHessian(const Hamiltonian& H, const Eigen::Vector3d& k, int band, double dk) {
+    Eigen::Matrix3d hess = Eigen::Matrix3d::Zero();
+    EigenWorkspace ws;
+    auto energy = [&](const Eigen::Vector3d& q) { H.eigensystem(q, ws); return ws.evals(band); };
+    for (int i = 0; i < 2; ++i) {
+        for (int j = 0; j < 2; ++j) {
+            const Eigen::Vector3d di = dk * Eigen::Vector3d::Unit(i), dj = dk * Eigen::Vector3d::Unit(j);
+            hess(i, j) = (energy(k + di + dj) - energy(k + di - dj) - energy(k - di + dj) + energy(k - di - dj))
+                         / (4.0 * dk * dk);
+        }
+    }
+    return hess;
+}
+
+/// @brief Finite-field σ(B_z) of SquareLattice from Chambers' formula, on the same mesh
+/// @details σ = τ Σ_k w_k (-∂f/∂E) v v̄ᵀ with v̄ = ∫_0^∞ dt/τ e^{-t/τ} v(k(t)) along the orbit
+/// dk/dt = v × B, integrated with RK4. Its expansion in B is the Jones–Zener series
+/// of computeMagnetoTransport, so the two differ at O(B³).
+Eigen::Matrix3d chambersConductivity(const Mesh& mesh, double Ef, double T, double tau, double Bz) {
+    auto velocity = [](const Eigen::Vector2d& q) { return Eigen::Vector2d(2.0 * std::sin(q(0)), 2.0 * std::sin(q(1))); };
+    auto flow = [&](const Eigen::Vector2d& q) {
+        const Eigen::Vector2d v = velocity(q);
+        return Eigen::Vector2d(v(1) * Bz, -v(0) * Bz);
+    };
+    const double dt = 0.05 * tau;
+    const int steps = static_cast<int>(25.0 * tau / dt);
+    const double decay = std::exp(-dt / tau);
+
+    Eigen::Matrix3d sigma = Eigen::Matrix3d::Zero();
+    for (size_t ik = 0; ik < mesh.size(); ++ik) {
+        Eigen::Vector2d q = mesh.getKPoints()[ik].head<2>();
+        const double energy = -2.0 * (std::cos(q(0)) + std::cos(q(1)));
+        const double x = (energy - Ef) / T;
+        if (std::abs(x) > 30.0) continue;
+        const double dfde = 1.0 / (4.0 * T * std::cosh(0.5 * x) * std::cosh(0.5 * x));
+
+        // Trapezoidal rule for the time integral, normalised so that B = 0 gives v̄ = v exactly
+        const Eigen::Vector2d v = velocity(q);
+        Eigen::Vector2d vbar = 0.5 * v;
+        double damping = 1.0, norm = 0.5;
+        for (int s = 0; s < steps; ++s) {
+            const Eigen::Vector2d k1 = flow(q), k2 = flow(q + 0.5 * dt * k1);
+            const Eigen::Vector2d k3 = flow(q + 0.5 * dt * k2), k4 = flow(q + dt * k3);
+            q += dt / 6.0 * (k1 + 2.0 * k2 + 2.0 * k3 + k4);
+            damping *= decay;
+            const double trapezoid = (s + 1 == steps ? 0.5 : 1.0) * damping;
+            vbar += trapezoid * velocity(q);
+            norm += trapezoid;
+        }
+        sigma.topLeftCorner<2, 2>() += mesh.weights()[ik] * tau * dfde * v * (vbar / norm).transpose();
+    }
+    return sigma;
+}
+
+int main() {
+    const double tau = 1.0;
+    const double T = 0.05;
+
+    // 1. Perturbative Hessians against finite-difference eigensolves
+    HaldaneModel haldane(1.0, 0.1, M_PI / 2.0, 0.2);
+    AltermagnetModel altermagnet(1.0, 0.3, 0.5);
+    HkOnly altermagnetHk(altermagnet);
+    const Mesh small = Mesh::monkhorstPack(altermagnet.reciprocalBasis(), 4, 4);
+    const Eigen::Vector3d k(0.37, -1.21, 0.0);
+
+    double hessian_error = 0.0;
+    std::cout << "Band Hessian max |perturbative - finite difference|:\n";
+    const Hamiltonian* models[] = {&haldane, &altermagnet, &altermagnetHk};
+    const char* names[] = {"Haldane (analytic dH)", "Altermagnet (analytic dH)", "Altermagnet (Hk only)"};
+    for (int m = 0; m < 3; ++m) {
+        BoltzmannSolver solver(*models[m], small, tau);
+        double error = 0.0;
+        for (int band = 0; band < 2; ++band) {
+            const Eigen::Matrix3d diff = solver.secondDerivatives(k, band) - finiteDifferenceHessian(*models[m], k, band, 1e-4);
+            error = std::max(error, diff.cwiseAbs().maxCoeff());
+        }
+        std::cout << "  " << names[m] << ": " << error << "\n";
+        hessian_error = std::max(hessian_error, error);
+    }
+
+    // 2. Hall coefficient of a nearly empty / nearly full band: R_H = -1/n (electrons), +1/p (holes)
+    SquareLattice square;
+    const Mesh mesh = Mesh::monkhorstPack(square.reciprocalBasis(), 200, 200);
+    BoltzmannSolver squareSolver(square, mesh, tau);
+    double hall_error = 0.0;
+    std::cout << "\nSquare lattice, T = " << T << ":\n# Ef  filling  R_H  R_H*n (electrons: -1, holes: +1 with n -> 1-n)  MR(B=0.1)\n";
+    for (double Ef : {-3.5, 3.5}) {
+        double filling = 0.0;
+        for (size_t ik = 0; ik < mesh.size(); ++ik) {
+            const double e = square.Hk(mesh.getKPoints()[ik])(0, 0).real();
+            filling += mesh.weights()[ik] / (1.0 + std::exp((e - Ef) / T));
+        }
+        const MagnetoTransport mt = squareSolver.computeMagnetoTransport(Ef, T);
+        const double carriers = Ef < 0.0 ? filling : 1.0 - filling;
+        std::cout << Ef << "  " << filling << "  " << mt.hallCoefficient() << "  "
+                  << mt.hallCoefficient() * carriers << "  "
+                  << mt.magnetoresistance(Eigen::Vector3d(0.0, 0.0, 0.1)) << "\n";
+        hall_error = std::max(hall_error, std::abs(std::abs(mt.hallCoefficient() * carriers) - 1.0));
+    }
+
+    // Jones–Zener B-linear and B² terms against the finite-field Chambers solution: the
+    // B-dependent parts agree up to O(B³) (Hall, odd in B) and O(B⁴) (magnetoconductance, even)
+    const MagnetoTransport electrons = squareSolver.computeMagnetoTransport(-3.5, T);
+    const Eigen::Matrix3d sigma0 = chambersConductivity(mesh, -3.5, T, tau, 0.0);
+    const double sigma0_error = std::abs(sigma0(0, 0) - electrons.sigma.zero(0, 0)) / sigma0(0, 0);
+    double hall_b_error[2], mr_b_error[2];
+    int field = 0;
+    std::cout << "# Bz  sigma_xy (series, Chambers)  sigma_xx - sigma_xx(0) (series, Chambers)\n";
+    for (double Bz : {0.05, 0.1}) {
+        const Eigen::Matrix3d series = electrons.sigma.at(Eigen::Vector3d(0.0, 0.0, Bz));
+        const Eigen::Matrix3d chambers = chambersConductivity(mesh, -3.5, T, tau, Bz);
+        const double mr_series = series(0, 0) - electrons.sigma.zero(0, 0), mr_chambers = chambers(0, 0) - sigma0(0, 0);
+        std::cout << Bz << "  " << series(0, 1) << "  " << chambers(0, 1) << "  " << mr_series << "  " << mr_chambers << "\n";
+        hall_b_error[field] = std::abs(series(0, 1) - chambers(0, 1)) / std::abs(chambers(0, 1));
+        mr_b_error[field] = std::abs(mr_series - mr_chambers) / std::abs(mr_chambers);
+        ++field;
+    }
+    // Relative errors of the B-dependent parts are O(B²): doubling B quadruples them
+    const double hall_order = hall_b_error[1] / hall_b_error[0], mr_order = mr_b_error[1] / mr_b_error[0];
+    std::cout << "relative error vs Chambers: sigma0 " << sigma0_error << ", sigma_xy " << hall_b_error[0]
+              << " (x" << hall_order << " at 2B), magnetoconductance " << mr_b_error[0] << " (x" << mr_order
+              << " at 2B)" << std::endl;
+
+    // 3. Field sweep of the altermagnet from one mesh pass
+    const Mesh amMesh = Mesh::monkhorstPack(altermagnet.reciprocalBasis(), 200, 200);
+    BoltzmannSolver amSolver(altermagnet, amMesh, tau);
+    const MagnetoTransport mt = amSolver.computeMagnetoTransport(0.5, T);
+    const Eigen::Matrix3d& s1 = mt.sigma.linear[2];
+    std::cout << "\nAltermagnet (t, J, lambda) = (1, 0.3, 0.5), Ef = 0.5:\n";
+    std::cout << "sigma1_z antisymmetry |xy + yx| / |xy| = " << std::abs(s1(0, 1) + s1(1, 0)) / std::abs(s1(0, 1)) << "\n";
+    std::cout << "Weak-field R_H = " << mt.hallCoefficient() << "\n";
+    std::cout << "# Bz  sigma_xx  sigma_xy  rho_xx  R_H(Bz)  MR_xx\n";
+    for (double Bz : {0.0, 0.02, 0.05, 0.1, 0.2}) {
+        const Eigen::Vector3d B(0.0, 0.0, Bz);
+        const Eigen::Matrix3d sigmaB = mt.sigma.at(B);
+        std::cout << Bz << "  " << sigmaB(0, 0) << "  " << sigmaB(0, 1) << "  " << mt.resistivity(B)(0, 0) << "  "
+                  << mt.hallCoefficient(Bz) << "  " << mt.magnetoresistance(B) << "\n";
+    }
+
+    const bool ok = hessian_error < 1e-6 && hall_error < 5e-3 && sigma0_error < 1e-6
+                    && hall_b_error[0] < 2e-2 && mr_b_error[0] < 2e-2
+                    && hall_order > 3.0 && hall_order < 5.0 && mr_order > 3.0 && mr_order < 5.0
+                    && std::abs(s1(0, 1) + s1(1, 0)) < 1e-12 * std::abs(s1(0, 1));
+    std::cout << (ok ? "OK" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -1,9 +1,11 @@
 #include "mesh.hpp"
+#include <cmath>
 #include <iostream>
 
 
 int main() {
-    
+    bool ok = true;
+
     Mesh mesh(5,5); // 2D 5x5 mesh
     const auto& kpoints = mesh.getKPoints();
 
@@ -12,7 +14,46 @@ int main() {
         std::cout << kp.transpose() << "\n";
     }
 
-    return 0;
+    // Box meshes include both ends of each axis; the trapezoidal weights still sum to 1
+    double box_weight = 0.0;
+    for (double w : mesh.weights()) box_weight += w;
+    const double corner_expected = 1.0 / (4.0 * (5 - 1) * (5 - 1)); // 1 / (4 (nx - 1)(ny - 1))
+    const bool box_ok = std::abs(box_weight - 1.0) < 1e-12 && std::abs(mesh.weights().front() - corner_expected) < 1e-15;
+    std::cout << "box weights: corner " << mesh.weights().front() << " (expected " << corner_expected << "), sum "
+              << box_weight << (box_ok ? "" : "  FAIL") << "\n";
+    ok = ok && box_ok;
+
+    // Monkhorst-Pack mesh of a hexagonal zone: every periodic image exactly once
+    Eigen::Matrix3d basis = Eigen::Matrix3d::Zero();
+    basis.col(0) << 2.0 * M_PI, 2.0 * M_PI / std::sqrt(3.0), 0.0;
+    basis.col(1) << 2.0 * M_PI, -2.0 * M_PI / std::sqrt(3.0), 0.0;
+    basis(2, 2) = 2.0 * M_PI;
+    Mesh mp = Mesh::monkhorstPack(basis, 4, 4, 1, Eigen::Vector3d(0.5, 0.5, 0.0));
+    std::cout << "Monkhorst-Pack 4x4 (shifted): " << mp.size() << " k-points, weight "
+              << mp.weights().front() << "\n";
+    for (const auto& kp : mp.getKPoints()) {
+        std::cout << kp.transpose() << "\n";
+    }
+
+    // Weights sum to 1 and no two points are images of each other (fractional coordinates mod 1)
+    double mp_weight = 0.0;
+    for (double w : mp.weights()) mp_weight += w;
+    const Eigen::Matrix3d to_fractional = basis.inverse();
+    int duplicates = 0;
+    for (size_t i = 0; i < mp.size(); ++i) {
+        for (size_t j = i + 1; j < mp.size(); ++j) {
+            Eigen::Vector3d d = to_fractional * (mp.getKPoints()[i] - mp.getKPoints()[j]);
+            d = d - d.array().round().matrix();
+            if (d.norm() < 1e-9) ++duplicates;
+        }
+    }
+    const bool mp_ok = mp.size() == 16 && duplicates == 0 && std::abs(mp_weight - 1.0) < 1e-12;
+    std::cout << "Monkhorst-Pack: weight sum " << mp_weight << ", " << duplicates << " periodic duplicates"
+              << (mp_ok ? "" : "  FAIL") << "\n";
+    ok = ok && mp_ok;
+
+    std::cout << (ok ? "OK" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
 }
 
 /*
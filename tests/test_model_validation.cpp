@@ -0,0 +1,39 @@
+#include "haldane.hpp"
+#include "altermagnet.hpp"
+#include "kane_mele.hpp"
+#include "mesh.hpp"
+#include "model_validation.hpp"
+#include <iostream>
+
+int main() {
+    Mesh mesh(40, 40); // 2D mesh, sampled by the validator
+
+    // Haldane model: hermitian and periodic; φ ≠ 0, π breaks time reversal
+    HaldaneModel haldane(1.0, 0.1, M_PI / 2.0, 0.2);
+    const ValidationReport haldane_report = validateModel(haldane, mesh);
+    std::cout << "Haldane model:\n" << haldane_report;
+
+    // Altermagnet model
+    AltermagnetModel altermagnet(1.0, 0.5, 0.1);
+    const ValidationReport altermagnet_report = validateModel(altermagnet, mesh);
+    std::cout << "Altermagnet model:\n" << altermagnet_report;
+
+    // Kane-Mele model with the spinful time-reversal operator Θ = i s_y K.
+    // The k-independent λ_SO σ_z s_z term of this simplified model is odd under Θ,
+    // so the time-reversal check is expected to report a violation of order 2λ_SO.
+    KaneMeleModel kane_mele(1.0, 0.1, 0.2, false);
+    ValidationOptions options;
+    options.checkTimeReversal = true;
+    options.timeReversalU = KaneMeleModel::timeReversalOperator();
+    const ValidationReport kane_mele_report = validateModel(kane_mele, mesh, options);
+    std::cout << "Kane-Mele model:\n" << kane_mele_report;
+
+    // Haldane and altermagnet pass; Kane-Mele is hermitian and periodic but fails time reversal,
+    // by far more than the tolerance (not a round-off failure)
+    const bool ok = haldane_report.passed() && altermagnet_report.passed()
+                    && kane_mele_report.hermitian && kane_mele_report.periodic
+                    && !kane_mele_report.timeReversalSymmetric && !kane_mele_report.passed()
+                    && kane_mele_report.timeReversalError > 1e6 * options.tolerance;
+    std::cout << (ok ? "OK" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+#pragma once
+#include "hamiltonian.hpp"
+#include "haldane.hpp"
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <vector>
+
+/// @file test_models.hpp
+/// @brief Model wrappers shared by the test programs
+
+/// @brief Same H(k) as the wrapped model, but the generic eigensolver and finite-difference ∂H
+/// @details Hides every override of the model (closed forms, analytic dHdk, term decomposition)
+/// except H(k) and the reciprocal basis, so fast paths can be checked against the generic ones.
+class HkOnly : public Hamiltonian {
+public:
+    explicit HkOnly(const Hamiltonian& model) : model(model) {}
+    Mat Hk(const Vec& k) const override { return model.Hk(k); }
+    void Hk(const Vec& k, Mat& out) const override { model.Hk(k, out); }
+    Eigen::Matrix3d reciprocalBasis() const override { return model.reciprocalBasis(); }
+private:
+    const Hamiltonian& model;
+};
+
+/// @brief N isolated bands: levels 0, 1, ..., N-1 with nearest-neighbour hopping on a square lattice
+/// @details H(k) = diag(0..N-1) + Σ_{d=x,y} (T_d e^{ik_d} + h.c.), T_d = 0.1 + weak random
+/// inter-orbital terms (fixed seed). Every band stays within ±0.45 of its level, so no bands
+/// cross: a smooth many-band model for interpolation and generic-eigensolver benchmarks.
+class IsolatedBandsModel : public Hamiltonian {
+public:
+    IsolatedBandsModel(int N, unsigned seed) {
+        std::srand(seed);
+        levels = Mat::Zero(N, N);
+        for (int i = 0; i < N; ++i) levels(i, i) = i;
+        for (auto& T : hopping) T = 0.1 * Mat::Identity(N, N) + (0.01 / std::sqrt(double(N))) * Mat::Random(N, N);
+    }
+
+    Mat Hk(const Vec& k) const override {
+        Mat H = levels;
+        for (int d = 0; d < 2; ++d) {
+            const Mat term = std::polar(1.0, k(d)) * hopping[d];
+            H += term + term.adjoint();
+        }
+        return H;
+    }
+
+    bool dHdk(const Vec& k, int direction, Mat& out) const override {
+        if (direction > 1) {
+            out.setZero(levels.rows(), levels.cols());
+            return true;
+        }
+        const Mat term = std::complex<double>(0.0, 1.0) * std::polar(1.0, k(direction)) * hopping[direction];
+        out = term + term.adjoint();
+        return true;
+    }
+
+private:
+    Mat levels;
+    Mat hopping[2];
+};
+
+/// @brief N orbitals with hoppings up to range r on a square lattice, split into three terms
+/// @details H(k) = c_0 H_0 + c_1 H_1(k) + c_2 H_2(k): on-site matrix, nearest shell (max(|a|,|b|) = 1)
+/// and all longer hoppings, each H_p(k) = Σ_R (T_R e^{ik·R} + h.c.) over one half of its shell
+/// (random T_R decaying with |R|, fixed seed). No analytic ∂H, so solvers difference H(k): the
+/// kind of model whose H(k) and ∂H assembly dominates and that a TermCache speeds up.
+class LongRangeModel : public Hamiltonian {
+public:
+    LongRangeModel(int N, int range, unsigned seed, const Eigen::Vector3d& coefficients = Eigen::Vector3d::Ones())
+        : coeffs(coefficients) {
+        std::srand(seed);
+        onsite = Mat::Random(N, N);
+        onsite = (0.5 * (onsite + onsite.adjoint())).eval();
+        for (int a = 0; a <= range; ++a) {
+            for (int b = -range; b <= range; ++b) {
+                if (a == 0 && b <= 0) continue; // one R of each ±R pair
+                const double distance = std::sqrt(double(a * a + b * b));
+                hoppings.push_back({Eigen::Vector3d(a, b, 0.0), std::exp(-distance) * Mat::Random(N, N),
+                                    std::max(std::abs(a), std::abs(b)) == 1 ? 1 : 2});
+            }
+        }
+    }
+
+    Mat Hk(const Vec& k) const override {
+        std::vector<Mat> terms;
+        termMatrices(k, terms);
+        return coeffs(0) * terms[0] + coeffs(1) * terms[1] + coeffs(2) * terms[2];
+    }
+
+    int numTerms() const override { return 3; }
+
+    void termMatrices(const Vec& k, std::vector<Mat>& terms) const override {
+        terms.assign(3, Mat::Zero(onsite.rows(), onsite.cols()));
+        terms[0] = onsite;
+        for (const Hopping& h : hoppings) {
+            const Mat term = std::polar(1.0, k.dot(h.R)) * h.T;
+            terms[h.term] += term + term.adjoint();
+        }
+    }
+
+    Eigen::VectorXd termCoefficients() const override { return coeffs; }
+
+private:
+    struct Hopping {
+        Eigen::Vector3d R;
+        Mat T;
+        int term;
+    };
+    Mat onsite;
+    std::vector<Hopping> hoppings;
+    Eigen::Vector3d coeffs;
+};
+
+/// @brief Spinful Haldane model: spin up sees phase φ, spin down -φ
+/// @details The pair is time-reversal symmetric, so Z2 = |C_up| mod 2, the charge Hall
+/// response cancels and the spin Hall response is σ_xy(up) - σ_xy(down). Basis (A↑, B↑, A↓, B↓).
+class SpinfulHaldane : public Hamiltonian {
+public:
+    SpinfulHaldane(double t2, double phi, double M) : up(1.0, t2, phi, M), down(1.0, t2, -phi, M) {}
+
+    Mat Hk(const Vec& k) const override {
+        Mat H = Mat::Zero(4, 4);
+        H.block(0, 0, 2, 2) = up.Hk(k);
+        H.block(2, 2, 2, 2) = down.Hk(k);
+        return H;
+    }
+
+    Eigen::Matrix3d reciprocalBasis() const override { return up.reciprocalBasis(); }
+
+    const HaldaneModel& spinUp() const { return up; }
+    const HaldaneModel& spinDown() const { return down; }
+
+private:
+    HaldaneModel up, down;
+};
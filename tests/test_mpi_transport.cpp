@@ -0,0 +1,70 @@
+#include "haldane.hpp"
+#include "mesh.hpp"
+#include "kubo.hpp"
+#include "boltzmann.hpp"
+#include "distributed.hpp"
+#include <mpi.h>
+#include <algorithm>
+#include <iostream>
+#include <Eigen/Dense>
+
+/*
+Run with a varying number of ranks; the tensors must not depend on it:
+    mpirun -np 1 ./bin/test_mpi_transport
+    mpirun -np 4 ./bin/test_mpi_transport
+*/
+int main(int argc, char* argv[]) {
+    MPI_Init(&argc, &argv);
+
+    size_t N = 30; // Grid resolution
+    Mesh mesh(N, N); // 2D mesh, split across ranks inside the solvers
+
+    HaldaneModel H(1.0, 0.1, M_PI / 2.0);
+
+    double Ef = 0.0;
+    double T = 0.01;
+    double eta = 1e-2;
+    double tau = 1.0;
+    Eigen::Vector3d Efield(1.0, 0.0, 0.0);
+    Eigen::Vector3d gradT(1.0, 0.0, 0.0);
+    Eigen::Vector3d Bfield(0.0, 0.0, 0.0);
+
+    KuboSolver kubo(H, mesh, eta, false, 1.0);
+    BoltzmannSolver boltzmann(H, mesh, tau, false, 1.0);
+
+    // Distributed: each rank sums its block of the mesh
+    auto [sigma_kubo, alpha_kubo, kappa_kubo] = kubo.computeTransportTensors(Ef, T);
+    auto [sigma_bolt, alpha_bolt] = boltzmann.computeTransportTensors(Ef, T, gradT, Efield, Bfield);
+
+    // Serial reference: rank 0 sums the whole mesh alone, then shares it
+    Eigen::Matrix<double, 3, 12> reference = Eigen::Matrix<double, 3, 12>::Zero();
+    if (Distributed::rank() == 0) {
+        Distributed::SerialScope serial;
+        auto [sigma_k, alpha_k, kappa_k] = kubo.computeTransportTensors(Ef, T);
+        auto [sigma_b, alpha_b] = boltzmann.computeTransportTensors(Ef, T, gradT, Efield, Bfield);
+        reference << sigma_k, alpha_k, sigma_b, alpha_b;
+    }
+    MPI_Bcast(reference.data(), static_cast<int>(reference.size()), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+    // Every rank compares its reduced tensors with the reference (summation order differs)
+    const Eigen::Matrix3d* results[4] = {&sigma_kubo, &alpha_kubo, &sigma_bolt, &alpha_bolt};
+    double error = 0.0;
+    for (int t = 0; t < 4; ++t) {
+        const Eigen::Matrix3d ref = reference.middleCols<3>(3 * t);
+        error = std::max(error, (*results[t] - ref).norm() / std::max(ref.norm(), 1e-30));
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &error, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    const bool ok = error < 1e-10;
+
+    if (Distributed::rank() == 0) {
+        std::cout << "Ranks: " << Distributed::size() << "\n";
+        std::cout << "Kubo conductivity tensor (σ_ij):\n" << sigma_kubo << std::endl;
+        std::cout << "Boltzmann conductivity tensor (σ_ij):\n" << sigma_bolt << std::endl;
+        std::cout << "Boltzmann thermopower tensor (α_ij):\n" << alpha_bolt << std::endl;
+        std::cout << "Max relative deviation from the serial reference: " << error << "\n";
+        std::cout << (ok ? "OK" : "FAIL") << std::endl;
+    }
+
+    MPI_Finalize();
+    return ok ? 0 : 1;
+}
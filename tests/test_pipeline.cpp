@@ -0,0 +1,110 @@
+#include "haldane.hpp"
+#include "mesh.hpp"
+#include "dos.hpp"
+#include "kubo.hpp"
+#include "boltzmann.hpp"
+#include "geometry.hpp"
+#include "pipeline.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <Eigen/Dense>
+
+/// @brief Stage that fails on its third chunk
+class FailingStage : public PipelineStage {
+public:
+    bool needsVelocities() const override { return false; }
+    void begin(const Mesh&, Eigen::Index) override { seen = 0; }
+    void consume(const BandChunk&) override {
+        if (++seen == 3) throw std::runtime_error("stage failure");
+    }
+private:
+    int seen = 0;
+};
+
+int main() {
+    using clock = std::chrono::steady_clock;
+    auto seconds = [](clock::time_point a, clock::time_point b) { return std::chrono::duration<double>(b - a).count(); };
+
+    HaldaneModel H(1.0, 0.1, M_PI / 2.0, 0.2);
+    const Mesh mesh = Mesh::monkhorstPack(H.reciprocalBasis(), 150, 150);
+    const double Ef = 0.5, T = 0.05, eta = 0.05, tau = 1.0;
+    const Eigen::Vector3d gradT(1.0, 0.0, 0.0), Efield(1.0, 0.0, 0.0), Bfield(0.0, 0.0, 0.0);
+
+    // Separate passes, one diagonalization per solver
+    const auto t0 = clock::now();
+    DOS dos(H, mesh);
+    const std::vector<double> dos_ref = dos.computeDOS(-4.0, 4.0, 200, 0.05);
+    KuboSolver kubo(H, mesh, eta);
+    auto [sigma_kubo, alpha_kubo, kappa_kubo] = kubo.computeTransportTensors(Ef, T);
+    BoltzmannSolver bolt(H, mesh, tau);
+    auto [sigma_bolt, alpha_bolt] = bolt.computeTransportTensors(Ef, T, gradT, Efield, Bfield);
+    BerryWorkspace bws;
+    const Eigen::MatrixXd berry_ref = berryCurvatureBatch(H, mesh.getKPoints(), 1e-4, bws);
+    const auto t1 = clock::now();
+
+    // One streaming pass
+    PipelineOptions options;
+    options.chunkSize = 512;
+    options.queueDepth = 2;
+    options.producers = 2;
+    BandPipeline pipeline(H, mesh, options);
+    DOSStage dosStage(-4.0, 4.0, 200, 0.05);
+    KuboStage kuboStage(Ef, T, eta);
+    BoltzmannStage boltStage(bolt, Ef, T, gradT, Efield, Bfield);
+    BerryCurvatureStage berryStage;
+    pipeline.addStage(dosStage);
+    pipeline.addStage(kuboStage);
+    pipeline.addStage(boltStage);
+    pipeline.addStage(berryStage);
+    pipeline.run();
+    const auto t2 = clock::now();
+
+    double dos_diff = 0.0;
+    for (size_t i = 0; i < dos_ref.size(); ++i) dos_diff = std::max(dos_diff, std::abs(dos_ref[i] - dosStage.dos()[i]));
+
+    std::cout << "Haldane, " << mesh.size() << " k-points, chunks of " << options.chunkSize << "\n";
+    std::cout << "max |pipeline - solver|:\n";
+    std::cout << "  DOS              " << dos_diff << "\n";
+    const double kubo_diff = std::max((kuboStage.sigma() - sigma_kubo).cwiseAbs().maxCoeff() / sigma_kubo.cwiseAbs().maxCoeff(),
+                                      (kuboStage.alpha() - alpha_kubo).cwiseAbs().maxCoeff() / alpha_kubo.cwiseAbs().maxCoeff());
+    const double bolt_diff = std::max((boltStage.sigma() - sigma_bolt).cwiseAbs().maxCoeff() / sigma_bolt.cwiseAbs().maxCoeff(),
+                                      (boltStage.alpha() - alpha_bolt).cwiseAbs().maxCoeff() / alpha_bolt.cwiseAbs().maxCoeff());
+    const double berry_diff = (berryStage.curvature() - berry_ref).cwiseAbs().maxCoeff() / berry_ref.cwiseAbs().maxCoeff();
+    const double dos_max = *std::max_element(dos_ref.begin(), dos_ref.end());
+    std::cout << "  Kubo sigma       " << (kuboStage.sigma() - sigma_kubo).cwiseAbs().maxCoeff()
+              << "  (sigma_xy " << kuboStage.sigma()(0, 1) << ")\n";
+    std::cout << "  Kubo alpha       " << (kuboStage.alpha() - alpha_kubo).cwiseAbs().maxCoeff() << "\n";
+    std::cout << "  Boltzmann sigma  " << (boltStage.sigma() - sigma_bolt).cwiseAbs().maxCoeff()
+              << "  (sigma_xx " << boltStage.sigma()(0, 0) << ")\n";
+    std::cout << "  Boltzmann alpha  " << (boltStage.alpha() - alpha_bolt).cwiseAbs().maxCoeff() << "\n";
+    std::cout << "  Berry (vs FHS)   " << (berryStage.curvature() - berry_ref).cwiseAbs().maxCoeff()
+              << "  (max |Omega| " << berry_ref.cwiseAbs().maxCoeff() << ")\n";
+    std::cout << "Separate passes " << seconds(t0, t1) << " s, pipeline " << seconds(t1, t2) << " s\n";
+    std::cout << "Peak chunks alive: " << pipeline.peakChunks() << " (bound "
+              << options.producers + 4 * (options.queueDepth + 1) << ")\n";
+
+    // A failing stage stops the pipeline and the exception reaches the caller
+    BandPipeline failing(H, mesh, options);
+    FailingStage bad;
+    failing.addStage(dosStage);
+    failing.addStage(bad);
+    bool propagated = false;
+    try {
+        failing.run();
+        std::cout << "Failing stage: no exception -> FAIL\n";
+    } catch (const std::runtime_error& e) {
+        propagated = true;
+        std::cout << "Failing stage: caught \"" << e.what() << "\" -> OK\n";
+    }
+
+    // Same sums as the solvers up to summation order; Berry is the perturbative Ω against
+    // FHS plaquettes, which agree to the plaquette discretization
+    const bool ok = dos_diff < 1e-12 * dos_max && kubo_diff < 1e-12 && bolt_diff < 1e-12 && berry_diff < 1e-3
+                    && pipeline.peakChunks() <= static_cast<size_t>(options.producers + 4 * (options.queueDepth + 1))
+                    && propagated;
+    std::cout << (ok ? "OK" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
+}
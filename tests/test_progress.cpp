@@ -0,0 +1,58 @@
+#include "progress.hpp"
+#include "haldane.hpp"
+#include "mesh.hpp"
+#include "kubo.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+/*
+ProgressReporter counts from every thread of a parallel loop without locks,
+and the solvers report one tick per k-point when a reporter is attached.
+*/
+
+int main() {
+    // Parallel loop: every iteration bumps the counter once. The bar stays open for another
+    // 0.3 s, so the 20 Hz reporter draws several times, but far fewer than once per item.
+    const size_t n = 200000;
+    const double rate_hz = 20.0;
+    std::ostringstream bar;
+    ProgressReporter reporter("loop", rate_hz, bar);
+    auto t0 = std::chrono::steady_clock::now();
+    reporter.start(n);
+    #pragma omp parallel for
+    for (long i = 0; i < static_cast<long>(n); ++i) {
+        reporter.add();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    reporter.finish();
+    auto t1 = std::chrono::steady_clock::now();
+    const double elapsed = std::chrono::duration<double>(t1 - t0).count();
+
+    // Every draw ends in '\r'; the reporter thread draws at most once per period, plus the final draw
+    const std::string drawn = bar.str();
+    const size_t draws = static_cast<size_t>(std::count(drawn.begin(), drawn.end(), '\r'));
+    const size_t max_draws = static_cast<size_t>(elapsed * rate_hz) + 2;
+    const bool complete = drawn.find("100% (200000/200000)") != std::string::npos;
+    std::cout << "parallel loop: counted " << reporter.count() << " of " << n << " in " << elapsed
+              << " s, " << draws << " draws (at most " << max_draws << "), final line "
+              << (complete ? "complete" : "INCOMPLETE") << std::endl;
+
+    // Solver hook: one tick per k-point of the mesh
+    HaldaneModel haldane(1.0, 0.1, M_PI / 2.0, 0.2);
+    Mesh mesh(40, 40);
+    KuboSolver kubo(haldane, mesh, 1e-2);
+    ProgressReporter kubo_progress("Kubo", 5.0, std::cout);
+    kubo.setProgress(&kubo_progress);
+    auto [sigma, alpha, kappa] = kubo.computeTransportTensors(0.0, 0.02);
+    std::cout << "Kubo sigma_xy = " << sigma(0, 1) << ", k-points reported "
+              << kubo_progress.count() << " of " << mesh.size() << std::endl;
+
+    const bool ok = reporter.count() == n && complete && draws >= 2 && draws <= max_draws
+                    && kubo_progress.count() == mesh.size();
+    std::cout << (ok ? "OK" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+#include "haldane.hpp"
+#include "mesh.hpp"
+#include "geometry.hpp"
+#include "pipeline.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <Eigen/Dense>
+
+/// @brief Two-band Weyl semimetal d = (sin kx, sin ky, m - cos kx - cos ky - cos kz)
+class WeylModel : public TwoBandModel {
+public:
+    explicit WeylModel(double m) : m(m) {}
+
+    void pauliVector(const Vec& k, double& eps, Eigen::Vector3d& d) const override {
+        eps = 0.0;
+        d << std::sin(k(0)), std::sin(k(1)), m - std::cos(k(0)) - std::cos(k(1)) - std::cos(k(2));
+    }
+
+    void pauliGradient(const Vec& k, Eigen::Vector3d& grad_eps, Eigen::Matrix3d& grad_d) const override {
+        grad_eps.setZero();
+        grad_d << std::cos(k(0)), 0.0,            0.0,
+                  0.0,            std::cos(k(1)), 0.0,
+                  std::sin(k(0)), std::sin(k(1)), std::sin(k(2));
+    }
+
+private:
+    double m;
+};
+
+/// @brief ∂_i d̂ by central differences of the normalized Pauli vector
+Eigen::Matrix3d unitVectorGradient(const TwoBandModel& model, const Eigen::Vector3d& k, double dk) {
+    Eigen::Matrix3d grad;
+    double eps;
+    Eigen::Vector3d plus, minus;
+    for (int i = 0; i < 3; ++i) {
+        const Eigen::Vector3d step = dk * Eigen::Vector3d::Unit(i);
+        model.pauliVector(k + step, eps, plus);
+        model.pauliVector(k - step, eps, minus);
+        grad.col(i) = (plus.normalized() - minus.normalized()) / (2.0 * dk);
+    }
+    return grad;
+}
+
+int main() {
+    using clock = std::chrono::steady_clock;
+    auto seconds = [](clock::time_point a, clock::time_point b) { return std::chrono::duration<double>(b - a).count(); };
+
+    // 1. Two-band closed forms in 3D: g_ij = ¼ ∂_i d̂·∂_j d̂, Ω_c = ∓½ d̂·(∂_a d̂ × ∂_b d̂) (lower / upper band)
+    const WeylModel weyl(2.0);
+    BerryWorkspace ws;
+    QuantumGeometricTensor qgt;
+    double metric_err = 0.0, curvature_err = 0.0;
+    for (const Eigen::Vector3d& k : {Eigen::Vector3d(0.3, -1.1, 0.7), Eigen::Vector3d(2.2, 0.4, -1.9), Eigen::Vector3d(-0.6, 0.9, 1.3)}) {
+        quantumGeometricTensor(weyl, k, 3, 1e-4, ws, qgt);
+        double eps;
+        Eigen::Vector3d d;
+        weyl.pauliVector(k, eps, d);
+        const Eigen::Vector3d n = d.normalized();
+        const Eigen::Matrix3d dn = unitVectorGradient(weyl, k, 1e-5);
+        const Eigen::Matrix3d g = 0.25 * dn.transpose() * dn;
+        Eigen::Vector3d omega;
+        for (int c = 0; c < 3; ++c) omega(c) = -0.5 * n.dot(dn.col((c + 1) % 3).cross(dn.col((c + 2) % 3)));
+        for (int band = 0; band < 2; ++band) {
+            metric_err = std::max(metric_err, (qgt.metric(band) - g).cwiseAbs().maxCoeff());
+            curvature_err = std::max(curvature_err, (qgt.curvature(band) - (band == 0 ? omega : -omega)).cwiseAbs().maxCoeff());
+        }
+    }
+    std::cout << "Weyl model, max |QGT - closed form|: metric " << metric_err << ", curvature " << curvature_err << "\n";
+
+    // 2. Haldane mesh: one pass for metric and curvature vs FHS plaquettes per band
+    const HaldaneModel haldane(1.0, 0.1, M_PI / 2.0, 0.2);
+    const Mesh mesh = Mesh::monkhorstPack(haldane.reciprocalBasis(), 120, 120);
+    const auto t0 = clock::now();
+    const Eigen::MatrixXd fhs = berryCurvatureBatch(haldane, mesh.getKPoints(), 1e-4, ws);
+    const auto t1 = clock::now();
+    const QuantumGeometryMap map = quantumGeometryBatch(haldane, mesh.getKPoints(), mesh.dimension(), 1e-5, ws);
+    const auto t2 = clock::now();
+
+    double omega_err = 0.0, trace = 0.0;
+    for (size_t ik = 0; ik < mesh.size(); ++ik) {
+        for (int band = 0; band < 2; ++band) omega_err = std::max(omega_err, std::abs(map.curvatureAt(ik, band)(2) - fhs(ik, band)));
+        trace += mesh.weights()[ik] * map.metricAt(ik, 0).trace();
+    }
+    std::cout << "Haldane " << mesh.size() << " k-points: max |Omega_z - FHS| " << omega_err
+              << " (max |Omega| " << fhs.cwiseAbs().maxCoeff() << "), BZ mean of tr g " << trace << "\n";
+    std::cout << "FHS (curvature only) " << seconds(t0, t1) << " s, QGT batch " << seconds(t1, t2) << " s\n";
+
+    // 3. The same from the streaming pipeline
+    BandPipeline pipeline(haldane, mesh);
+    QuantumGeometryStage stage;
+    pipeline.addStage(stage);
+    pipeline.run();
+    const double pipeline_err = std::max((stage.geometry().metric - map.metric).cwiseAbs().maxCoeff(),
+                                         (stage.geometry().curvature - map.curvature).cwiseAbs().maxCoeff());
+    std::cout << "Pipeline vs batch: max |difference| " << pipeline_err << "\n";
+
+    // Closed forms to finite-difference accuracy, FHS to its plaquette discretization error
+    const bool ok = metric_err < 1e-8 && curvature_err < 1e-8
+                    && omega_err < 1e-3 * fhs.cwiseAbs().maxCoeff() && pipeline_err < 1e-12;
+    std::cout << (ok ? "OK" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+#include "altermagnet.hpp"
+#include "term_cache.hpp"
+#include "mesh.hpp"
+#include "kubo.hpp"
+#include "boltzmann.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include "test_models.hpp"
+
+/*
+Term decomposition and TermCache. The altermagnet of params.ini checks that cached and
+rebuilt models agree (it is a closed-form two-band model, which the cache cannot speed up:
+sweep it directly). The sweep of a long-range multi-orbital model without analytic ∂H compares
+rebuilding the model for every point with one TermCache and a CachedHamiltonian with new
+coefficients; only the accuracy is checked here, the speedup is checked by validate_fast_paths.
+*/
+
+/// @brief max |a - b| / max(max |b|, floor) (the floor keeps vanishing Hall responses from amplifying round-off)
+double relativeError(const Eigen::Matrix3d& a, const Eigen::Matrix3d& b, double floor = 1e-30) {
+    return (a - b).cwiseAbs().maxCoeff() / std::max(b.cwiseAbs().maxCoeff(), floor);
+}
+
+int main() {
+    using clock = std::chrono::steady_clock;
+    auto seconds = [](clock::time_point a, clock::time_point b) { return std::chrono::duration<double>(b - a).count(); };
+    Mesh mesh(60, 60, 1, M_PI);
+    const double Ef = 0.5, T = 0.02, eta = 1e-2, tau = 100.0;
+    const Eigen::Vector3d E(1.0, 0.0, 0.0), gradT(1.0, 0.0, 0.0), B(0.0, 0.0, 1.0), zero = Eigen::Vector3d::Zero();
+
+    // 1. The decompositions reproduce H(k)
+    AltermagnetModel reference(1.0, 0.3, 0.5);
+    const LongRangeModel long_range(8, 3, 5, Eigen::Vector3d(1.0, 0.7, 0.4));
+    std::vector<Eigen::MatrixXcd> terms;
+    double decomposition_error = 0.0;
+    for (const Hamiltonian* model : {static_cast<const Hamiltonian*>(&reference), static_cast<const Hamiltonian*>(&long_range)}) {
+        for (const auto& k : {Eigen::Vector3d(0.3, -1.2, 0.0), Eigen::Vector3d(2.9, 0.4, 0.0)}) {
+            model->termMatrices(k, terms);
+            const Eigen::VectorXd c = model->termCoefficients();
+            Eigen::MatrixXcd sum = c(0) * terms[0];
+            for (int p = 1; p < model->numTerms(); ++p) sum += c(p) * terms[p];
+            decomposition_error = std::max(decomposition_error, (sum - model->Hk(k)).norm());
+        }
+    }
+    std::cout << "term decomposition error: " << decomposition_error << std::endl;
+
+    // 2. Altermagnet: cached and rebuilt models agree (Kubo, and Boltzmann with fields)
+    const TermCache altermagnet_cache(reference, mesh);
+    CachedHamiltonian cached_altermagnet(altermagnet_cache, Eigen::Vector3d(1.0, 0.0, 0.0));
+    double kubo_error = 0.0, bolt_error = 0.0;
+    for (double lambda : {0.0, 0.5}) {
+        for (double J : {0.2, 0.8}) {
+            AltermagnetModel model(1.0, J, lambda);
+            cached_altermagnet.setCoefficients(Eigen::Vector3d(1.0, J, lambda));
+            const auto [sigma_k, alpha_k, kappa_k] = KuboSolver(model, mesh, eta).computeTransportTensors(Ef, T);
+            const auto [sigma_kc, alpha_kc, kappa_kc] = KuboSolver(cached_altermagnet, mesh, eta).computeTransportTensors(Ef, T);
+            const auto [sigma_b, alpha_b] = BoltzmannSolver(model, mesh, tau, false, 1.0).computeTransportTensors(Ef, T, gradT, E, B);
+            const auto [sigma_bc, alpha_bc] = BoltzmannSolver(cached_altermagnet, mesh, tau, false, 1.0).computeTransportTensors(Ef, T, gradT, E, B);
+            kubo_error = std::max(kubo_error, relativeError(sigma_kc, sigma_k, 1.0));
+            bolt_error = std::max(bolt_error, relativeError(sigma_bc, sigma_b));
+        }
+    }
+    std::cout << "altermagnet, cached vs rebuilt: max relative Δσ Kubo " << kubo_error
+              << ", Boltzmann " << bolt_error << std::endl;
+
+    // 3. Sweep of the long-range model (no fields: Boltzmann then only needs band velocities)
+    const Mesh sweep_mesh(40, 40, 1, M_PI);
+    const auto t0 = clock::now();
+    const TermCache cache(long_range, sweep_mesh);
+    const auto t1 = clock::now();
+    std::cout << "cache: " << cache.size() << " k-points, " << cache.memoryBytes() / 1024 << " KiB, "
+              << seconds(t0, t1) << " s" << std::endl;
+
+    double direct_time = 0.0, cached_time = seconds(t0, t1);
+    double sweep_kubo_error = 0.0, sweep_bolt_error = 0.0;
+    CachedHamiltonian cached(cache, Eigen::Vector3d(1.0, 1.0, 1.0));
+    int points = 0;
+    for (double c1 : {0.4, 1.2}) {
+        for (double c2 : {0.0, 1.0}) {
+            const Eigen::Vector3d coefficients(1.0, c1, c2);
+            const auto t2 = clock::now();
+            const LongRangeModel model(8, 3, 5, coefficients);
+            const auto [sigma_k, alpha_k, kappa_k] = KuboSolver(model, sweep_mesh, eta).computeTransportTensors(Ef, T);
+            const auto [sigma_b, alpha_b] = BoltzmannSolver(model, sweep_mesh, tau, false, 1.0).computeTransportTensors(Ef, T, zero, zero, zero);
+            const auto t3 = clock::now();
+
+            cached.setCoefficients(coefficients);
+            const auto [sigma_kc, alpha_kc, kappa_kc] = KuboSolver(cached, sweep_mesh, eta).computeTransportTensors(Ef, T);
+            const auto [sigma_bc, alpha_bc] = BoltzmannSolver(cached, sweep_mesh, tau, false, 1.0).computeTransportTensors(Ef, T, zero, zero, zero);
+            const auto t4 = clock::now();
+
+            direct_time += seconds(t2, t3);
+            cached_time += seconds(t3, t4);
+            sweep_kubo_error = std::max(sweep_kubo_error, relativeError(sigma_kc, sigma_k, 1.0));
+            sweep_bolt_error = std::max(sweep_bolt_error, relativeError(sigma_bc, sigma_b));
+            ++points;
+        }
+    }
+
+    const double speedup = direct_time / cached_time;
+    std::cout << "sweep of " << points << " parameter points, 8 orbitals (Kubo + Boltzmann)\n"
+              << "  rebuilt models:            " << direct_time << " s\n"
+              << "  term cache (incl. build):  " << cached_time << " s, speedup " << speedup << "\n"
+              << "  max relative Δσ Kubo " << sweep_kubo_error << ", Boltzmann " << sweep_bolt_error << std::endl;
+
+    const bool ok = decomposition_error < 1e-12 && kubo_error < 1e-8 && bolt_error < 1e-6
+                    && sweep_kubo_error < 1e-6 && sweep_bolt_error < 1e-4;
+    std::cout << (ok ? "OK" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,57 @@
+#include "haldane.hpp"
+#include "topology.hpp"
+#include <cmath>
+#include <iostream>
+#include "test_models.hpp"
+
+int main() {
+    bool ok = true;
+
+    // WCC flow of the Chern insulator: one centre winds once as k1 goes around the zone
+    HaldaneModel haldane(1.0, 0.1, M_PI / 2.0, 0.2);
+    WilsonLoop haldane_loop(haldane, 1, 64);
+    WannierCenterFlow flow = haldane_loop.flow(11, 0.0, 1.0);
+    std::cout << "# Haldane WCC flow (k1, x)\n";
+    for (size_t i = 0; i < flow.k1.size(); ++i) {
+        std::cout << flow.k1[i] << "  " << flow.centers[i][0] << "\n";
+    }
+
+    // Winding over k1 in [0, 1]: sum of the Berry-phase steps folded into [-1/2, 1/2), on strings
+    // dense enough that no step reaches 1/2; equals the Chern number of the occupied band
+    const WannierCenterFlow dense_flow = haldane_loop.flow(41, 0.0, 1.0);
+    double winding = 0.0;
+    for (size_t i = 1; i < dense_flow.berryPhase.size(); ++i) {
+        const double step = dense_flow.berryPhase[i] - dense_flow.berryPhase[i - 1];
+        winding += step - std::floor(step + 0.5);
+    }
+    const int haldane_chern = chernNumber(haldane, 1, 12);
+    const bool winds_once = std::abs(winding - haldane_chern) < 1e-6 && std::abs(haldane_chern) == 1;
+    std::cout << "WCC winding " << winding << " (Chern number " << haldane_chern << ")"
+              << (winds_once ? "" : "  FAIL") << "\n";
+    ok = ok && winds_once;
+
+    // Z2 across the topological transition (for this Haldane mass term the gap closes near M ≈ 0.35)
+    std::cout << "\n# Spinful Haldane Z2 (M, Z2, expected)\n";
+    for (const auto& [M, expected] : {std::make_pair(0.0, 1), std::make_pair(0.2, 1), std::make_pair(0.3, 1),
+                                      std::make_pair(0.5, 0), std::make_pair(1.0, 0)}) {
+        SpinfulHaldane model(0.1, M_PI / 2.0, M);
+        WilsonLoop loop(model, 2, 64);
+        const int z2 = loop.z2Invariant(41);
+        std::cout << M << "  " << z2 << "  " << expected << (z2 == expected ? "" : "  FAIL") << "\n";
+        ok = ok && z2 == expected;
+    }
+
+    // Lattice Chern number on coarse grids of the hexagonal zone: integers without oversampling
+    std::cout << "\n# Haldane Chern number (M, C on 6x6, 12x12, 48x48, expected)\n";
+    for (const auto& [M, expected] : {std::make_pair(0.0, -1), std::make_pair(0.2, -1),
+                                      std::make_pair(0.5, 0), std::make_pair(1.0, 0)}) {
+        HaldaneModel model(1.0, 0.1, M_PI / 2.0, M);
+        const int c6 = chernNumber(model, 1, 6), c12 = chernNumber(model, 1, 12), c48 = chernNumber(model, 1, 48);
+        const bool match = c6 == expected && c12 == expected && c48 == expected;
+        std::cout << M << "  " << c6 << "  " << c12 << "  " << c48 << "  " << expected << (match ? "" : "  FAIL") << "\n";
+        ok = ok && match;
+    }
+
+    std::cout << (ok ? "OK" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
+}
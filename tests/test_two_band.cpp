@@ -0,0 +1,79 @@
+#include "haldane.hpp"
+#include "altermagnet.hpp"
+#include "geometry.hpp"
+#include <chrono>
+#include <iostream>
+#include <Eigen/Dense>
+#include "test_models.hpp"
+
+int main() {
+    using clock = std::chrono::steady_clock;
+    HaldaneModel haldane(1.0, 0.1, M_PI / 2.0, 0.2);
+    AltermagnetModel altermagnet(1.0, 0.3, 0.5);
+    const TwoBandModel* models[] = {&haldane, &altermagnet};
+    const char* names[] = {"Haldane", "Altermagnet"};
+    const Eigen::Vector3d kpoints[] = {{0.37, -1.21, 0.0}, {2.1, 0.4, 0.0}, {-0.8, 2.9, 0.0}};
+    const double dk = 1e-5;
+
+    // Closed forms against the generic eigensolver, finite-difference velocities and FHS plaquettes
+    std::cout << "max |closed form - generic|:\n# model  energies  velocities  Omega (vs FHS, dk = 1e-4)\n";
+    bool ok = true;
+    for (int m = 0; m < 2; ++m) {
+        const HkOnly generic(*models[m]);
+        EigenWorkspace ws, plus, minus;
+        BerryWorkspace bws;
+        TwoBandGeometry geometry;
+        double e_err = 0.0, v_err = 0.0, omega_err = 0.0;
+        for (const auto& k : kpoints) {
+            models[m]->bandGeometry(k, geometry);
+            generic.eigensystem(k, ws);
+            e_err = std::max(e_err, (geometry.energies - ws.evals).cwiseAbs().maxCoeff());
+            for (int band = 0; band < 2; ++band) {
+                for (int i = 0; i < 2; ++i) {
+                    const Eigen::Vector3d step = dk * Eigen::Vector3d::Unit(i);
+                    generic.eigensystem(k + step, plus);
+                    generic.eigensystem(k - step, minus);
+                    const double v_fd = (plus.evals(band) - minus.evals(band)) / (2.0 * dk);
+                    v_err = std::max(v_err, std::abs(geometry.velocities(i, band) - v_fd));
+                }
+                omega_err = std::max(omega_err, std::abs(geometry.omega(band) - berryCurvatureFHS(generic, k, 1e-4, band, bws)));
+            }
+        }
+        std::cout << names[m] << "  " << e_err << "  " << v_err << "  " << omega_err << "\n";
+        ok = ok && e_err < 1e-10 && v_err < 1e-8 && omega_err < 1e-4;
+    }
+
+    // Cost per k-point of both bands: closed form vs eigensolver + finite differences + FHS
+    const int samples = 20000;
+    const HkOnly generic(haldane);
+    EigenWorkspace ws, plus, minus;
+    BerryWorkspace bws;
+    TwoBandGeometry geometry;
+    double sink = 0.0;
+    const auto t0 = clock::now();
+    for (int s = 0; s < samples; ++s) {
+        const Eigen::Vector3d k(0.001 * s, -0.0007 * s, 0.0);
+        haldane.bandGeometry(k, geometry);
+        sink += geometry.omega(0) + geometry.velocities(0, 1);
+    }
+    const auto t1 = clock::now();
+    for (int s = 0; s < samples; ++s) {
+        const Eigen::Vector3d k(0.001 * s, -0.0007 * s, 0.0);
+        generic.eigensystem(k, ws);
+        for (int i = 0; i < 2; ++i) {
+            generic.eigensystem(k + dk * Eigen::Vector3d::Unit(i), plus);
+            generic.eigensystem(k - dk * Eigen::Vector3d::Unit(i), minus);
+            sink += plus.evals(1) - minus.evals(1);
+        }
+        berryCurvatureFHSAllBands(generic, k, 1e-4, bws, ws.evals);
+        sink += ws.evals(0);
+    }
+    const auto t2 = clock::now();
+    const double closed = std::chrono::duration<double>(t1 - t0).count();
+    const double reference = std::chrono::duration<double>(t2 - t1).count();
+    std::cout << "\nHaldane, " << samples << " k-points: closed form " << closed << " s, generic "
+              << reference << " s, speedup " << reference / closed << " (checksum " << sink << ")\n";
+
+    std::cout << (ok ? "OK" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
+}